@@ -7,14 +7,32 @@
 #define FS_ETPU_ENTRY_TABLE _ENTRY_TABLE_BASE_ADDR_
 #define FS_ETPU_MISC _MISC_VALUE_
 #define FS_ETPU_ENGINE_MEM_SIZE _ENGINE_DATA_SIZE_
+
+/* 0x6F8B6640 is the original two function image - etpu_set_defines.h,
+   etpu_set_struct.h and etpu_set_idata.h describe the current SPI_master and
+   SPI_slave entry tables and frames, so the code image must be rebuilt by
+   ETEC before the host is */
+#if _MISC_VALUE_ == 0x6F8B6640
+#error "etpu_set_scm.h is not of the current eTPU code - rebuild the eTPU code with ETEC"
+#endif
+
 /*#define FS_ETPU_C_ENTRY_TABLE _ENTRY_TABLE_BASE_ADDR_C_
 #define FS_ETPU_C_MISC _MISC_VALUE_C_
 #define FS_ETPU_C_ENGINE_MEM_SIZE _ENGINE_DATA_SIZE_C_
 */
 
+/* the code image, run-length compressed at build time (etpu_code_rle_gen) -
+   fs_etpu_init_rle_ext loads it; the raw image is only linked for
+   fs_etpu_init_ext, define FS_ETPU_CODE_RLE_ONLY to leave it out */
+const unsigned int etpu_code_rle[] = {
+#include "etpu_set_scm_rle.h"
+};
+
+#ifndef FS_ETPU_CODE_RLE_ONLY
 unsigned int etpu_code[] = {
 #include "etpu_set_scm.h"
 };
+#endif
 
 unsigned int etpu_globals[] =
 {
@@ -26,18 +26,27 @@
 #define FS_ETPU_SPI_MASTER_INIT_TCR1_HSR  7
 #define FS_ETPU_SPI_MASTER_INIT_TCR2_HSR  5
 #define FS_ETPU_SPI_MASTER_RUN_HSR  3
+#define FS_ETPU_SPI_MASTER_COUNTERS_HSR  6
 #define FS_ETPU_SPI_MASTER_CPHA_0_FM0  0
 #define FS_ETPU_SPI_MASTER_CPHA_1_FM0  1
 #define FS_ETPU_SPI_MASTER_SHIFT_DIR_MSB_FM1  0
 #define FS_ETPU_SPI_MASTER_SHIFT_DIR_LSB_FM1  1
 #define FS_ETPU_SPI_MASTER_MAX_SLAVE_SELECT_CNT  4
+#define FS_ETPU_SPI_MASTER_XFER_WORD  0
+#define FS_ETPU_SPI_MASTER_XFER_BURST  1
+#define FS_ETPU_SPI_MASTER_XFER_CHAIN  2
+#define FS_ETPU_SPI_MASTER_XFER_STREAM  3
 #define FS_ETPU_SPI_SLAVE_INIT_HSR  1
 #define FS_ETPU_SPI_SLAVE_INIT_SS_HSR  2
 #define FS_ETPU_SPI_SLAVE_SET_DATA_HSR  7
+#define FS_ETPU_SPI_SLAVE_COUNTERS_HSR  6
 #define FS_ETPU_SPI_SLAVE_CPHA_0_FM0  0
 #define FS_ETPU_SPI_SLAVE_CPHA_1_FM0  1
 #define FS_ETPU_SPI_SLAVE_SHIFT_DIR_MSB_FM1  0
 #define FS_ETPU_SPI_SLAVE_SHIFT_DIR_LSB_FM1  1
+#define FS_ETPU_SPI_SLAVE_EDGE_BOTH  0
+#define FS_ETPU_SPI_SLAVE_EDGE_RISING  1
+#define FS_ETPU_SPI_SLAVE_EDGE_FALLING  2
 
 // exported autodef text from user "#pragma export_autodef_text" commands
 // none specified
@@ -110,17 +119,93 @@ write_chan_data24(FUNC2_CHAN4, _CPBA24_FUNC2___STACKBASE_, _ETPU_B_STACK_BASE_AD
 //============================================================================
 //==========     SPI_slave
 
+// Entry table SPI_slave_CPHA0_MSB
 // Register CXCR, field CFS, Function Number, Each Channel
-// CXCR.CFS = _FUNCTION_NUM_SPI_slave_;
-#define _FUNCTION_NUM_SPI_slave_                 0x01
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_CPHA0_MSB_;
+#define _FUNCTION_NUM_SPI_slave_CPHA0_MSB_       0x0E
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_CPHA0_MSB_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_CPHA0_MSB_   0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA0_MSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA0_MSB_ 0x00
+
+// Entry table SPI_slave_CPHA0_LSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_CPHA0_LSB_;
+#define _FUNCTION_NUM_SPI_slave_CPHA0_LSB_       0x0F
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_CPHA0_LSB_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_CPHA0_LSB_   0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA0_LSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA0_LSB_ 0x00
+
+// Entry table SPI_slave_CPHA1_MSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_CPHA1_MSB_;
+#define _FUNCTION_NUM_SPI_slave_CPHA1_MSB_       0x10
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_CPHA1_MSB_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_CPHA1_MSB_   0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA1_MSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA1_MSB_ 0x00
 
+// Entry table SPI_slave_CPHA1_LSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_CPHA1_LSB_;
+#define _FUNCTION_NUM_SPI_slave_CPHA1_LSB_       0x11
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_CPHA1_LSB_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_CPHA1_LSB_   0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA1_LSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA1_LSB_ 0x00
+
+// Entry table SPI_slave_CPHA0_CRC
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_CPHA0_CRC_;
+#define _FUNCTION_NUM_SPI_slave_CPHA0_CRC_       0x12
 // Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
-// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_;
-#define _ENTRY_TABLE_TYPE_SPI_slave_             0x01
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_CPHA0_CRC_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_CPHA0_CRC_   0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA0_CRC_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA0_CRC_ 0x00
 
+// Entry table SPI_slave_CPHA1_CRC
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_CPHA1_CRC_;
+#define _FUNCTION_NUM_SPI_slave_CPHA1_CRC_       0x13
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_CPHA1_CRC_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_CPHA1_CRC_   0x01
 // Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
-// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_;
-#define _ENTRY_TABLE_PIN_DIR_SPI_slave_          0x00
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA1_CRC_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_CPHA1_CRC_ 0x00
+
+// Entry table SPI_slave_EDGE_MSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_EDGE_MSB_;
+#define _FUNCTION_NUM_SPI_slave_EDGE_MSB_        0x14
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_EDGE_MSB_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_EDGE_MSB_    0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_EDGE_MSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_EDGE_MSB_ 0x00
+
+// Entry table SPI_slave_EDGE_LSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_slave_EDGE_LSB_;
+#define _FUNCTION_NUM_SPI_slave_EDGE_LSB_        0x15
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_slave_EDGE_LSB_;
+#define _ENTRY_TABLE_TYPE_SPI_slave_EDGE_LSB_    0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_slave_EDGE_LSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_slave_EDGE_LSB_ 0x00
 
 // 8-bit Channel Variable address offsets
 // address = ((CXCR.CPBA)<<3) + _CPBA8_SPI_slave__use_TCR1_
@@ -131,12 +216,30 @@ write_chan_data24(FUNC2_CHAN4, _CPBA24_FUNC2___STACKBASE_, _ETPU_B_STACK_BASE_AD
 #define _CPBA8_SPI_slave__bit_count_             0x04
 #define _CPBA8_SPI_slave__MISO_chan_             0x08
 #define _CPBA8_SPI_slave__selected_flag_         0x0C
+#define _CPBA8_SPI_slave__sample_edge_           0x10
+#define _CPBA8_SPI_slave__seg_bit_count_         0x14
+#define _CPBA8_SPI_slave__ss_cnt_                0x18
+#define _CPBA8_SPI_slave__ss_index_              0x1C
+#define _CPBA8_SPI_slave__data_in_index_         0x20
+#define _CPBA8_SPI_slave__rx_full_               0x24
+#define _CPBA8_SPI_slave__tx_fresh_              0x28
 
 // 24-bit Channel Variable address offsets
 // address = ((CXCR.CPBA)<<3) + _CPBA24_SPI_slave__data_out_reg_
 #define _CPBA24_SPI_slave__data_out_reg_         0x01
 #define _CPBA24_SPI_slave__data_in_reg_          0x05
 #define _CPBA24_SPI_slave__timeout_              0x09
+#define _CPBA24_SPI_slave__ss_poll_period_       0x0D
+#define _CPBA24_SPI_slave__miso_hold_            0x11
+#define _CPBA24_SPI_slave__crc_                  0x15
+#define _CPBA24_SPI_slave__reg_                  0x19
+#define _CPBA24_SPI_slave__frame_                0x1D
+#define _CPBA24_SPI_slave__long_                 0x21
+#define _CPBA24_SPI_slave__edge_                 0x25
+#define _CPBA24_SPI_slave__counters_             0x29
+#define _CPBA24_SPI_slave__ss_chan_pack_         0x2D
+#define _CPBA24_SPI_slave__dev_buf_              0x31
+#define _CPBA24_SPI_slave__attach_sum_           0x35
 
 // Channel Variable type information
 // Can be used in conjunction with other auto-define information to simplify interfaces
@@ -148,25 +251,185 @@ write_chan_data24(FUNC2_CHAN4, _CPBA24_FUNC2___STACKBASE_, _ETPU_B_STACK_BASE_AD
 #define _CPBA_TYPE_SPI_slave__timeout_           T_sint24
 #define _CPBA_TYPE_SPI_slave__MISO_chan_         T_sint8
 #define _CPBA_TYPE_SPI_slave__selected_flag_     T_sint8
+#define _CPBA_TYPE_SPI_slave__ss_poll_period_    T_sint24
+#define _CPBA_TYPE_SPI_slave__miso_hold_         T_sint24
+#define _CPBA_TYPE_SPI_slave__sample_edge_       T_sint8
+#define _CPBA_TYPE_SPI_slave__crc_               T_ptr
+#define _CPBA_TYPE_SPI_slave__reg_               T_ptr
+#define _CPBA_TYPE_SPI_slave__frame_             T_ptr
+#define _CPBA_TYPE_SPI_slave__long_              T_ptr
+#define _CPBA_TYPE_SPI_slave__edge_              T_ptr
+#define _CPBA_TYPE_SPI_slave__counters_          T_ptr
+#define _CPBA_TYPE_SPI_slave__seg_bit_count_     T_sint8
+#define _CPBA_TYPE_SPI_slave__ss_chan_pack_      T_uint24
+#define _CPBA_TYPE_SPI_slave__ss_cnt_            T_sint8
+#define _CPBA_TYPE_SPI_slave__ss_index_          T_sint8
+#define _CPBA_TYPE_SPI_slave__data_in_index_     T_sint8
+#define _CPBA_TYPE_SPI_slave__dev_buf_           T_ptr
+#define _CPBA_TYPE_SPI_slave__rx_full_           T_sint8
+#define _CPBA_TYPE_SPI_slave__tx_fresh_          T_sint8
+#define _CPBA_TYPE_SPI_slave__attach_sum_        T_uint24
 
 // Channel Frame Size, amount of RAM required for each channel
 // CXCR.CPBA (this) = CXCR.CPBA (last) + _FRAME_SIZE_SPI_slave_;
-#define _FRAME_SIZE_SPI_slave_                   0x18
+#define _FRAME_SIZE_SPI_slave_                   0x40
 
 //============================================================================
 //==========     SPI_master
 
+// Entry table SPI_master_CPHA0_MSB
 // Register CXCR, field CFS, Function Number, Each Channel
-// CXCR.CFS = _FUNCTION_NUM_SPI_master_;
-#define _FUNCTION_NUM_SPI_master_                0x00
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA0_MSB_;
+#define _FUNCTION_NUM_SPI_master_CPHA0_MSB_      0x00
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA0_MSB_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA0_MSB_  0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_MSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_MSB_ 0x01
 
+// Entry table SPI_master_CPHA0_LSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA0_LSB_;
+#define _FUNCTION_NUM_SPI_master_CPHA0_LSB_      0x01
 // Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
-// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_;
-#define _ENTRY_TABLE_TYPE_SPI_master_            0x01
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA0_LSB_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA0_LSB_  0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_LSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_LSB_ 0x01
 
+// Entry table SPI_master_CPHA1_MSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA1_MSB_;
+#define _FUNCTION_NUM_SPI_master_CPHA1_MSB_      0x02
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA1_MSB_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA1_MSB_  0x01
 // Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
-// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_;
-#define _ENTRY_TABLE_PIN_DIR_SPI_master_         0x01
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_MSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_MSB_ 0x01
+
+// Entry table SPI_master_CPHA1_LSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA1_LSB_;
+#define _FUNCTION_NUM_SPI_master_CPHA1_LSB_      0x03
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA1_LSB_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA1_LSB_  0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_LSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_LSB_ 0x01
+
+// Entry table SPI_master_CPHA0_MSB_DLY
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA0_MSB_DLY_;
+#define _FUNCTION_NUM_SPI_master_CPHA0_MSB_DLY_  0x04
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA0_MSB_DLY_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA0_MSB_DLY_ 0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_MSB_DLY_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_MSB_DLY_ 0x01
+
+// Entry table SPI_master_CPHA0_LSB_DLY
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA0_LSB_DLY_;
+#define _FUNCTION_NUM_SPI_master_CPHA0_LSB_DLY_  0x05
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA0_LSB_DLY_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA0_LSB_DLY_ 0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_LSB_DLY_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_LSB_DLY_ 0x01
+
+// Entry table SPI_master_CPHA1_MSB_DLY
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA1_MSB_DLY_;
+#define _FUNCTION_NUM_SPI_master_CPHA1_MSB_DLY_  0x06
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA1_MSB_DLY_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA1_MSB_DLY_ 0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_MSB_DLY_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_MSB_DLY_ 0x01
+
+// Entry table SPI_master_CPHA1_LSB_DLY
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA1_LSB_DLY_;
+#define _FUNCTION_NUM_SPI_master_CPHA1_LSB_DLY_  0x07
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA1_LSB_DLY_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA1_LSB_DLY_ 0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_LSB_DLY_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_LSB_DLY_ 0x01
+
+// Entry table SPI_master_CPHA0_CRC
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA0_CRC_;
+#define _FUNCTION_NUM_SPI_master_CPHA0_CRC_      0x08
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA0_CRC_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA0_CRC_  0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_CRC_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_CRC_ 0x01
+
+// Entry table SPI_master_CPHA1_CRC
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA1_CRC_;
+#define _FUNCTION_NUM_SPI_master_CPHA1_CRC_      0x09
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA1_CRC_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA1_CRC_  0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_CRC_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_CRC_ 0x01
+
+// Entry table SPI_master_CPHA0_CRC_DLY
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA0_CRC_DLY_;
+#define _FUNCTION_NUM_SPI_master_CPHA0_CRC_DLY_  0x0A
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA0_CRC_DLY_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA0_CRC_DLY_ 0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_CRC_DLY_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA0_CRC_DLY_ 0x01
+
+// Entry table SPI_master_CPHA1_CRC_DLY
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_CPHA1_CRC_DLY_;
+#define _FUNCTION_NUM_SPI_master_CPHA1_CRC_DLY_  0x0B
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_CPHA1_CRC_DLY_;
+#define _ENTRY_TABLE_TYPE_SPI_master_CPHA1_CRC_DLY_ 0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_CRC_DLY_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_CPHA1_CRC_DLY_ 0x01
+
+// Entry table SPI_master_DDR_MSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_DDR_MSB_;
+#define _FUNCTION_NUM_SPI_master_DDR_MSB_        0x0C
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_DDR_MSB_;
+#define _ENTRY_TABLE_TYPE_SPI_master_DDR_MSB_    0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_DDR_MSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_DDR_MSB_ 0x01
+
+// Entry table SPI_master_DDR_LSB
+// Register CXCR, field CFS, Function Number, Each Channel
+// CXCR.CFS = _FUNCTION_NUM_SPI_master_DDR_LSB_;
+#define _FUNCTION_NUM_SPI_master_DDR_LSB_        0x0D
+// Register CXCR, field ETCS, Type (Alternate or Standard), Each Channel
+// CXCR.ETCS = _ENTRY_TABLE_TYPE_SPI_master_DDR_LSB_;
+#define _ENTRY_TABLE_TYPE_SPI_master_DDR_LSB_    0x01
+// Register CXCR, field ETPD, Pin Direction (Input or Output), Each Channel
+// CXCR.ETPD = _ENTRY_TABLE_PIN_DIR_SPI_master_DDR_LSB_;
+#define _ENTRY_TABLE_PIN_DIR_SPI_master_DDR_LSB_ 0x01
 
 // 8-bit Channel Variable address offsets
 // address = ((CXCR.CPBA)<<3) + _CPBA8_SPI_master__CPOL_
@@ -174,20 +437,29 @@ write_chan_data24(FUNC2_CHAN4, _CPBA24_FUNC2___STACKBASE_, _ETPU_B_STACK_BASE_AD
 #define _CPBA8_BOOLBITOFFSET_SPI_master__CPOL_   0x07
 #define _CPBA8_SPI_master__bit_count_            0x04
 #define _CPBA8_SPI_master__slave_select_chan_    0x08
+#define _CPBA8_SPI_master__slave_select_addr_    0x0C
+#define _CPBA8_SPI_master__ss_addr_chan_         0x10
+#define _CPBA8_SPI_master__ss_addr_bit_count_    0x14
+#define _CPBA8_SPI_master__angle_table_cnt_      0x18
+#define _CPBA8_SPI_master__xfer_mode_            0x1C
+#define _CPBA8_SPI_master__rx_full_              0x20
+#define _CPBA8_SPI_master__tx_fresh_             0x24
 
 // 24-bit Channel Variable address offsets
 // address = ((CXCR.CPBA)<<3) + _CPBA24_SPI_master__half_period_
 #define _CPBA24_SPI_master__half_period_         0x01
 #define _CPBA24_SPI_master__data_out_reg_        0x05
 #define _CPBA24_SPI_master__data_in_reg_         0x09
+#define _CPBA24_SPI_master__slave_select_chan_pack_ 0x0D
 #define _CPBA24_SPI_master__slave_select_delay_  0x11
-
-// Channel Array Variable address offsets
-// address = ((CXCR.CPBA)<<3) + _CPBA_ARRAY_SPI_master__slave_select_chan_list_
-#define _CPBA_ARRAY_SPI_master__slave_select_chan_list_ 0x0C
-#define _CPBA_TYPE_ARRAY_SPI_master__slave_select_chan_list_ T_uint8
-#define _CPBA_ARRAY_SPI_master__slave_select_chan_list_DIM_1_LENGTH_ 0x04
-#define _CPBA_ARRAY_SPI_master__slave_select_chan_list_DIM_1_STRIDE_ 0x01
+#define _CPBA24_SPI_master__angle_table_         0x15
+#define _CPBA24_SPI_master__crc_                 0x19
+#define _CPBA24_SPI_master__burst_               0x1D
+#define _CPBA24_SPI_master__chain_               0x21
+#define _CPBA24_SPI_master__stream_              0x25
+#define _CPBA24_SPI_master__counters_            0x29
+#define _CPBA24_SPI_master__miso_sample_delay_   0x2D
+#define _CPBA24_SPI_master__attach_sum_          0x31
 
 // Channel Variable type information
 // Can be used in conjunction with other auto-define information to simplify interfaces
@@ -196,12 +468,27 @@ write_chan_data24(FUNC2_CHAN4, _CPBA24_FUNC2___STACKBASE_, _ETPU_B_STACK_BASE_AD
 #define _CPBA_TYPE_SPI_master__bit_count_        T_sint8
 #define _CPBA_TYPE_SPI_master__data_out_reg_     T_uint24
 #define _CPBA_TYPE_SPI_master__data_in_reg_      T_uint24
-#define _CPBA_TYPE_SPI_master__slave_select_chan_list_ T_array
+#define _CPBA_TYPE_SPI_master__slave_select_chan_pack_ T_uint24
 #define _CPBA_TYPE_SPI_master__slave_select_chan_ T_uint8
 #define _CPBA_TYPE_SPI_master__slave_select_delay_ T_sint24
+#define _CPBA_TYPE_SPI_master__slave_select_addr_ T_uint8
+#define _CPBA_TYPE_SPI_master__ss_addr_chan_     T_uint8
+#define _CPBA_TYPE_SPI_master__ss_addr_bit_count_ T_sint8
+#define _CPBA_TYPE_SPI_master__angle_table_      T_ptr
+#define _CPBA_TYPE_SPI_master__angle_table_cnt_  T_sint8
+#define _CPBA_TYPE_SPI_master__crc_              T_ptr
+#define _CPBA_TYPE_SPI_master__burst_            T_ptr
+#define _CPBA_TYPE_SPI_master__chain_            T_ptr
+#define _CPBA_TYPE_SPI_master__stream_           T_ptr
+#define _CPBA_TYPE_SPI_master__xfer_mode_        T_sint8
+#define _CPBA_TYPE_SPI_master__counters_         T_ptr
+#define _CPBA_TYPE_SPI_master__miso_sample_delay_ T_sint24
+#define _CPBA_TYPE_SPI_master__rx_full_          T_sint8
+#define _CPBA_TYPE_SPI_master__tx_fresh_         T_sint8
+#define _CPBA_TYPE_SPI_master__attach_sum_       T_uint24
 
 // Channel Frame Size, amount of RAM required for each channel
 // CXCR.CPBA (this) = CXCR.CPBA (last) + _FRAME_SIZE_SPI_master_;
-#define _FRAME_SIZE_SPI_master_                  0x20
+#define _FRAME_SIZE_SPI_master_                  0x40
 
 #endif // __etpu_set_defines_H
@@ -31,6 +31,16 @@ __SPI_slave_CHAN_FRAME_INIT32( 0x0008 , 0x00000000 )
 __SPI_slave_CHAN_FRAME_INIT32( 0x000c , 0x00000000 )
 __SPI_slave_CHAN_FRAME_INIT32( 0x0010 , 0x00000000 )
 __SPI_slave_CHAN_FRAME_INIT32( 0x0014 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x0018 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x001c , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x0020 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x0024 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x0028 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x002c , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x0030 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x0034 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x0038 , 0x00000000 )
+__SPI_slave_CHAN_FRAME_INIT32( 0x003c , 0x00000000 )
 // SPI_master Channel Frame Initialization Data Macros
 
 #ifndef __SPI_master_CHAN_FRAME_INIT32
@@ -46,3 +56,11 @@ __SPI_master_CHAN_FRAME_INIT32( 0x0010 , 0x00000000 )
 __SPI_master_CHAN_FRAME_INIT32( 0x0014 , 0x00000000 )
 __SPI_master_CHAN_FRAME_INIT32( 0x0018 , 0x00000000 )
 __SPI_master_CHAN_FRAME_INIT32( 0x001c , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x0020 , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x0024 , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x0028 , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x002c , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x0030 , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x0034 , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x0038 , 0x00000000 )
+__SPI_master_CHAN_FRAME_INIT32( 0x003c , 0x00000000 )
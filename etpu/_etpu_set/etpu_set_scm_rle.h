@@ -0,0 +1,100 @@
+// This file is generated by etpu_code_rle_gen from etpu_set_scm.h.
+//    !!!   DO NOT EDIT THIS FILE   !!!
+
+// SCM run-length compressed for fs_etpu_init_rle_ext, 1468 of 16384 bytes
+// Data packaged for inclusion into an array initializer
+#if _MISC_VALUE_ != 0x6F8B6640
+#error "etpu_set_scm_rle.h is not of the current eTPU code - run etpu_code_rle_gen"
+#endif
+/*0x000*/ 0x524C4531, 0x00004000, 0xA65120B7, 0x0000000C,
+/*0x010*/ 0x022D0248, 0x022D0248, 0x022A0200, 0x032D032D,
+/*0x020*/ 0x424A424A, 0x42614261, 0x424A424A, 0x42614261,
+/*0x030*/ 0xC272C272, 0x42854285, 0xC272C272, 0x42854285,
+/*0x040*/ 0x80000004, 0x032D032D, 0x00000010, 0x02BF02BF,
+/*0x050*/ 0x82C282C2, 0x02B042EC, 0x032D032D, 0x4303C2D8,
+/*0x060*/ 0x4303032D, 0x4303C2D8, 0x4303032D, 0x42F3C2C9,
+/*0x070*/ 0xC2FB032D, 0x42F3C2C9, 0xC2FB032D, 0x42F3C2C9,
+/*0x080*/ 0xC2FB032D, 0x42F3C2C9, 0xC2FB032D, 0x800001E0,
+/*0x090*/ 0x032D032D, 0x00000147, 0x4FF00FFF, 0xF7F04067,
+/*0x0A0*/ 0x0FFFFE7E, 0x4FFFFFE5, 0xF3B040E7, 0x0FFFFFFE,
+/*0x0B0*/ 0x0FFFFF7E, 0xF5384167, 0x4FEFF6BF, 0xF7F04187,
+/*0x0C0*/ 0x495FFDFE, 0x4A3FFBFE, 0x4FF8FFFF, 0xFF3FFEFB,
+/*0x0D0*/ 0x1EF94FE7, 0x4FF9FFFF, 0x00000410, 0x00100408,
+/*0x0E0*/ 0x1C3AFEFF, 0xF0904527, 0x003A7409, 0x1F1A0FFF,
+/*0x0F0*/ 0x00095411, 0x00094419, 0xFFEFF8D9, 0x0C0B0BFA,
+/*0x100*/ 0x1809F792, 0x1C065602, 0x1C01D582, 0x0BF0FBEA,
+/*0x110*/ 0xF0D844E7, 0x00044419, 0xFFEFF8D9, 0x0C0B0BFA,
+/*0x120*/ 0x1809F792, 0x1C065602, 0x1C01D582, 0x00004411,
+/*0x130*/ 0x4FF8FBFE, 0xF7F04227, 0x000A1439, 0x0FFFFFFF,
+/*0x140*/ 0x4FF33FFF, 0xF7F04067, 0x0FFFFEFE, 0xF7F045E7,
+/*0x150*/ 0x000C2419, 0x4FEFF6BF, 0xCFEFF982, 0x0BF2FBEA,
+/*0x160*/ 0xF0D84727, 0xCFFFF905, 0xBFC91B84, 0x7F1E2F7F,
+/*0x170*/ 0x00024411, 0xF7F04747, 0x7FFA4DF6, 0x7F1E2F7F,
+/*0x180*/ 0xF3E848C9, 0xBFFFFB85, 0x1DF94FE7, 0xF3B04827,
+/*0x190*/ 0x4FF8FFFF, 0xF7F04847, 0x18087792, 0x1808778A,
+/*0x1A0*/ 0xF09048AD, 0xF7F048C7, 0x7FFFFBFE, 0x7FFFFDFE,
+/*0x1B0*/ 0xCFEFF981, 0xC7FFF984, 0xF7F045E7, 0x000D2419,
+/*0x1C0*/ 0xF3F84A27, 0x7FFFFEFF, 0x1EF94FE7, 0xF7604B6E,
+/*0x1D0*/ 0xB7F87B86, 0xF7F04B67, 0xBCF87B86, 0x7F1E3FDF,
+/*0x1E0*/ 0xCFEFF984, 0x1EF2AFFF, 0xCFFFF984, 0x1DF94FE7,
+/*0x1F0*/ 0xBFEFFB85, 0xB7F87A85, 0xF0904B47, 0x6FFFFBFE,
+/*0x200*/ 0x6FFFFDFE, 0x1DF94FE7, 0xBFEFFB80, 0x7F1E3FDF,
+/*0x210*/ 0xCFEFF984, 0x1EF2AFFF, 0xC7FFF984, 0xF3F84D07,
+/*0x220*/ 0x7FFFFEFF, 0x1EF94FE7, 0xF7604B6E, 0xB3F87B86,
+/*0x230*/ 0xF7F04B67, 0xBDF87B86, 0x7F1E3FDF, 0xCFEFF984,
+/*0x240*/ 0x1EF2AFFF, 0xCFFFF984, 0x1DF94FE7, 0xBFEFFB85,
+/*0x250*/ 0xB3F87A85, 0xF0904E27, 0x6FFFFBFE, 0x6FFFFDFE,
+/*0x260*/ 0xDFEFD985, 0x0802FBAA, 0xF0D04F27, 0xCFFF7905,
+/*0x270*/ 0xCFEFF982, 0x00024411, 0xF7773EF9, 0xF3D85007,
+/*0x280*/ 0xCFEFF984, 0x0002A019, 0xF0D854C7, 0x1DF94FE7,
+/*0x290*/ 0xF7E0530D, 0x18087792, 0x1EF94FE7, 0xF76053EE,
+/*0x2A0*/ 0xB7F87B86, 0xF7F053E7, 0xBCF87B86, 0xDFEFD985,
+/*0x2B0*/ 0x0802FBAA, 0xF0D05187, 0xCFFF7905, 0xCFEFF982,
+/*0x2C0*/ 0x00024411, 0xF7773EF9, 0xF3D85267, 0xCFEFF984,
+/*0x2D0*/ 0x0002A019, 0xF0D854C7, 0x1DF94FE7, 0xF7E0530D,
+/*0x2E0*/ 0x1808778A, 0x1EF94FE7, 0xF76053EE, 0xB3F87B86,
+/*0x2F0*/ 0xF7F053E7, 0xBDF87B86, 0xF090536D, 0xF7F05387,
+/*0x300*/ 0x7FFFFBFE, 0x7FFFFDFE, 0x1EF94FE7, 0xBFEFFB80,
+/*0x310*/ 0x6F132F7F, 0xCFEFF984, 0x0002A019, 0xF0F854A7,
+/*0x320*/ 0x1DF94FE7, 0xBFEFFB80, 0x6F132F7F, 0xF7D054C7,
+/*0x330*/ 0xBFEFFB86, 0xBFFFFB82, 0xCFEFF982, 0x0BF2FBEA,
+/*0x340*/ 0xF0D855C7, 0xBDEFAB80, 0xCFFFF985, 0x6F133FDF,
+/*0x350*/ 0xFFFF3EF9, 0xF7FF7EF9, 0xF5105667, 0xF7F05687,
+/*0x360*/ 0x4FF0FFFF, 0x4FF3FFFF, 0x5BE9F6B9, 0xDF38F904,
+/*0x370*/ 0x0C094F26, 0x4FF9FFFF, 0x00000448, 0x1C394FE7,
+/*0x380*/ 0xCFEFF983, 0x0802FBAA, 0xF0D057C7, 0x47F8FFFF,
+/*0x390*/ 0x47F9FFFF, 0x000FA439, 0xF7F05887, 0xCFFFF983,
+/*0x3A0*/ 0xF7F05887, 0xCFFFF903, 0x4FF9FFF9, 0x5BE0F6BF,
+/*0x3B0*/ 0xCFE9FA82, 0x1F1C2FFF, 0xF73FBEFB, 0x7FEFFFFF,
+/*0x3C0*/ 0xFFFF3EF9, 0xF7585A87, 0x000FA439, 0xCFFF3983,
+/*0x3D0*/ 0xCFFFF904, 0xCFEFF982, 0x00024411, 0xF3F85AE7,
+/*0x3E0*/ 0x4FF8FFFF, 0xF7D06387, 0xCFFFF903, 0x00024411,
+/*0x3F0*/ 0x4FF9FFFF, 0x0FFFFFFF, 0x7F1E2E7F, 0xF7785CA7,
+/*0x400*/ 0xCFEFF983, 0x0002A019, 0xF0D05D67, 0x000FA439,
+/*0x410*/ 0xCFFF3983, 0xCFFFF904, 0xCFEFF982, 0x00024411,
+/*0x420*/ 0xF3F85D67, 0x4FF8FFFF, 0xF7D06387, 0x0802FBAA,
+/*0x430*/ 0xF0D05D67, 0xCFFF3903, 0xCFEFF982, 0x00024411,
+/*0x440*/ 0x4FF9FFFF, 0x0FFFFFFF, 0xCFEFF983, 0x0802FBAA,
+/*0x450*/ 0xF0D05E47, 0xF3D85E47, 0xF7F06387, 0x1EF94FE7,
+/*0x460*/ 0x0FFFFFFF, 0xDFE7F983, 0x0002A019, 0xF0D05EE7,
+/*0x470*/ 0x0FFFFFFF, 0xF3F060C7, 0x0FFFFFFE, 0xF7F06387,
+/*0x480*/ 0x1EF94FE7, 0xDFE7F983, 0x0002A019, 0xF0D05FE7,
+/*0x490*/ 0x0FFFFFFF, 0xF3F860C7, 0x0FFFFF7E, 0xF7F06387,
+/*0x4A0*/ 0x1EF94FE7, 0xDFFA7904, 0x1EF94FE7, 0x47F9FFFF,
+/*0x4B0*/ 0x1DF94FE7, 0xF380618C, 0xF77061E7, 0xB7F87B84,
+/*0x4C0*/ 0x1E087382, 0xF7D061EC, 0xF77061E7, 0xB3F87B84,
+/*0x4D0*/ 0xBDF87B84, 0xCFEFF984, 0x00020439, 0x0009A419,
+/*0x4E0*/ 0xCFFFF984, 0xCFEFF981, 0x00021419, 0x1C59AEFF,
+/*0x4F0*/ 0xF0D06327, 0xCBFF3A81, 0xC7FFF904, 0x1EF94FE7,
+/*0x500*/ 0xCBEFFA82, 0x6F1E2F7F, 0xCFEFF984, 0x0002A019,
+/*0x510*/ 0xF0D06427, 0xBFEFFB80, 0xBFFFFB83, 0xF3B064A7,
+/*0x520*/ 0xBFEFFF83, 0xF7F064C7, 0x180B4792, 0x180B478A,
+/*0x530*/ 0xF0B06527, 0xBFFFFF83, 0x6FFFFBFE, 0x6FFFFDFE,
+/*0x540*/ 0xCFEFF000, 0xF7F066C7, 0x0C42AB82, 0xCFEFF000,
+/*0x550*/ 0xF7F066C7, 0x0E02AB82, 0xCFEFF000, 0xF7F066C7,
+/*0x560*/ 0x0D02AB82, 0xCFEFF000, 0xF7F066C7, 0x0C82AB82,
+/*0x570*/ 0xF3306727, 0x00097409, 0x0E01CB82, 0xF2506767,
+/*0x580*/ 0x0D01CB82, 0xF21067A7, 0x0C81CB82, 0xF2D067E7,
+/*0x590*/ 0x0C41CB82, 0xF2906827, 0x0C21CB82, 0xF4106867,
+/*0x5A0*/ 0x0C01CBA2, 0xF71068A7, 0x0E00DB82, 0x4FEFF6BF,
+/*0x5B0*/ 0xC7FFF000, 0x80000CB9, 0xFFD06667,
@@ -61,11 +61,52 @@ typedef struct
 	etpu_if_uint8 : 8;
 	etpu_if_uint8 : 8;
 	/* 0x0010 */
-	etpu_if_uint32 : 32;
+	etpu_if_sint8				_sample_edge;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
 	/* 0x0014 */
+	etpu_if_sint8				_seg_bit_count;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x0018 */
+	etpu_if_sint8				_ss_cnt;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x001c */
+	etpu_if_sint8				_ss_index;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x0020 */
+	etpu_if_sint8				_data_in_index;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x0024 */
+	etpu_if_sint8				_rx_full;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x0028 */
+	etpu_if_sint8				_tx_fresh;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x002c */
+	etpu_if_uint32 : 32;
+	/* 0x0030 */
+	etpu_if_uint32 : 32;
+	/* 0x0034 */
+	etpu_if_uint32 : 32;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
 	etpu_if_uint32 : 32;
 } etpu_if_SPI_slave_CHANNEL_FRAME;
-#define etpu_if_SPI_slave_CHANNEL_FRAME_EXPECTED_SIZE 24
+#define etpu_if_SPI_slave_CHANNEL_FRAME_EXPECTED_SIZE 64
 
 
 /* data structure of all 24-bit SPI_slave CHANNEL FRAME data (meant to be accessed via PSE mirror)*/
@@ -84,13 +125,33 @@ typedef struct
 	/* 0x0008 */
 	etpu_if_sint32				_timeout;
 	/* 0x000c */
-	etpu_if_uint32 : 32;
+	etpu_if_sint32				_ss_poll_period;
 	/* 0x0010 */
-	etpu_if_uint32 : 32;
+	etpu_if_sint32				_miso_hold;
 	/* 0x0014 */
+	etpu_if_uint32				_crc;
+	/* 0x0018 */
+	etpu_if_uint32				_reg;
+	/* 0x001c */
+	etpu_if_uint32				_frame;
+	/* 0x0020 */
+	etpu_if_uint32				_long;
+	/* 0x0024 */
+	etpu_if_uint32				_edge;
+	/* 0x0028 */
+	etpu_if_uint32				_counters;
+	/* 0x002c */
+	etpu_if_uint32				_ss_chan_pack;
+	/* 0x0030 */
+	etpu_if_uint32				_dev_buf;
+	/* 0x0034 */
+	etpu_if_uint32				_attach_sum;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
 	etpu_if_uint32 : 32;
 } etpu_if_SPI_slave_CHANNEL_FRAME_PSE;
-#define etpu_if_SPI_slave_CHANNEL_FRAME_PSE_EXPECTED_SIZE 24
+#define etpu_if_SPI_slave_CHANNEL_FRAME_PSE_EXPECTED_SIZE 64
 
 
 /* data structure of all signed 24-bit SPI_slave CHANNEL FRAME data (meant to be accessed via PSE mirror)*/
@@ -106,13 +167,33 @@ typedef struct
 	/* 0x0008 */
 	etpu_if_sint32				_timeout;
 	/* 0x000c */
-	etpu_if_uint32 : 32;
+	etpu_if_sint32				_ss_poll_period;
 	/* 0x0010 */
-	etpu_if_uint32 : 32;
+	etpu_if_sint32				_miso_hold;
 	/* 0x0014 */
 	etpu_if_uint32 : 32;
+	/* 0x0018 */
+	etpu_if_uint32 : 32;
+	/* 0x001c */
+	etpu_if_uint32 : 32;
+	/* 0x0020 */
+	etpu_if_uint32 : 32;
+	/* 0x0024 */
+	etpu_if_uint32 : 32;
+	/* 0x0028 */
+	etpu_if_uint32 : 32;
+	/* 0x002c */
+	etpu_if_uint32 : 32;
+	/* 0x0030 */
+	etpu_if_uint32 : 32;
+	/* 0x0034 */
+	etpu_if_uint32 : 32;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
+	etpu_if_uint32 : 32;
 } etpu_if_SPI_slave_CHANNEL_FRAME_signedPSE;
-#define etpu_if_SPI_slave_CHANNEL_FRAME_signedPSE_EXPECTED_SIZE 24
+#define etpu_if_SPI_slave_CHANNEL_FRAME_signedPSE_EXPECTED_SIZE 64
 
 
 /* data structure of all unsigned 24-bit SPI_slave CHANNEL FRAME data (meant to be accessed via PSE mirror)*/
@@ -135,9 +216,29 @@ typedef struct
 	/* 0x0010 */
 	etpu_if_uint32 : 32;
 	/* 0x0014 */
+	etpu_if_uint32				_crc;
+	/* 0x0018 */
+	etpu_if_uint32				_reg;
+	/* 0x001c */
+	etpu_if_uint32				_frame;
+	/* 0x0020 */
+	etpu_if_uint32				_long;
+	/* 0x0024 */
+	etpu_if_uint32				_edge;
+	/* 0x0028 */
+	etpu_if_uint32				_counters;
+	/* 0x002c */
+	etpu_if_uint32				_ss_chan_pack;
+	/* 0x0030 */
+	etpu_if_uint32				_dev_buf;
+	/* 0x0034 */
+	etpu_if_uint32				_attach_sum;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
 	etpu_if_uint32 : 32;
 } etpu_if_SPI_slave_CHANNEL_FRAME_unsignedPSE;
-#define etpu_if_SPI_slave_CHANNEL_FRAME_unsignedPSE_EXPECTED_SIZE 24
+#define etpu_if_SPI_slave_CHANNEL_FRAME_unsignedPSE_EXPECTED_SIZE 64
 
 
 /* data structure (map) of all non-24-bit SPI_master CHANNEL FRAME data */
@@ -175,17 +276,54 @@ typedef struct
 	etpu_if_uint8 : 8;
 	etpu_if_uint8 : 8;
 	/* 0x000c */
-	etpu_if_uint8				_slave_select_chan_list[4];
+	etpu_if_uint8				_slave_select_addr;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
 	/* 0x0010 */
-	etpu_if_uint32 : 32;
+	etpu_if_uint8				_ss_addr_chan;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
 	/* 0x0014 */
-	etpu_if_uint32 : 32;
+	etpu_if_sint8				_ss_addr_bit_count;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
 	/* 0x0018 */
-	etpu_if_uint32 : 32;
+	etpu_if_sint8				_angle_table_cnt;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
 	/* 0x001c */
+	etpu_if_sint8				_xfer_mode;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x0020 */
+	etpu_if_sint8				_rx_full;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x0024 */
+	etpu_if_sint8				_tx_fresh;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	etpu_if_uint8 : 8;
+	/* 0x0028 */
+	etpu_if_uint32 : 32;
+	/* 0x002c */
+	etpu_if_uint32 : 32;
+	/* 0x0030 */
+	etpu_if_uint32 : 32;
+	/* 0x0034 */
+	etpu_if_uint32 : 32;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
 	etpu_if_uint32 : 32;
 } etpu_if_SPI_master_CHANNEL_FRAME;
-#define etpu_if_SPI_master_CHANNEL_FRAME_EXPECTED_SIZE 32
+#define etpu_if_SPI_master_CHANNEL_FRAME_EXPECTED_SIZE 64
 
 
 /* data structure of all 24-bit SPI_master CHANNEL FRAME data (meant to be accessed via PSE mirror)*/
@@ -204,17 +342,33 @@ typedef struct
 	/* 0x0008 */
 	etpu_if_uint32				_data_in_reg;
 	/* 0x000c */
-	etpu_if_uint32 : 32;
+	etpu_if_uint32				_slave_select_chan_pack;
 	/* 0x0010 */
 	etpu_if_sint32				_slave_select_delay;
 	/* 0x0014 */
-	etpu_if_uint32 : 32;
+	etpu_if_uint32				_angle_table;
 	/* 0x0018 */
-	etpu_if_uint32 : 32;
+	etpu_if_uint32				_crc;
 	/* 0x001c */
+	etpu_if_uint32				_burst;
+	/* 0x0020 */
+	etpu_if_uint32				_chain;
+	/* 0x0024 */
+	etpu_if_uint32				_stream;
+	/* 0x0028 */
+	etpu_if_uint32				_counters;
+	/* 0x002c */
+	etpu_if_sint32				_miso_sample_delay;
+	/* 0x0030 */
+	etpu_if_uint32				_attach_sum;
+	/* 0x0034 */
+	etpu_if_uint32 : 32;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
 	etpu_if_uint32 : 32;
 } etpu_if_SPI_master_CHANNEL_FRAME_PSE;
-#define etpu_if_SPI_master_CHANNEL_FRAME_PSE_EXPECTED_SIZE 32
+#define etpu_if_SPI_master_CHANNEL_FRAME_PSE_EXPECTED_SIZE 64
 
 
 /* data structure of all signed 24-bit SPI_master CHANNEL FRAME data (meant to be accessed via PSE mirror)*/
@@ -239,8 +393,24 @@ typedef struct
 	etpu_if_uint32 : 32;
 	/* 0x001c */
 	etpu_if_uint32 : 32;
+	/* 0x0020 */
+	etpu_if_uint32 : 32;
+	/* 0x0024 */
+	etpu_if_uint32 : 32;
+	/* 0x0028 */
+	etpu_if_uint32 : 32;
+	/* 0x002c */
+	etpu_if_sint32				_miso_sample_delay;
+	/* 0x0030 */
+	etpu_if_uint32 : 32;
+	/* 0x0034 */
+	etpu_if_uint32 : 32;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
+	etpu_if_uint32 : 32;
 } etpu_if_SPI_master_CHANNEL_FRAME_signedPSE;
-#define etpu_if_SPI_master_CHANNEL_FRAME_signedPSE_EXPECTED_SIZE 32
+#define etpu_if_SPI_master_CHANNEL_FRAME_signedPSE_EXPECTED_SIZE 64
 
 
 /* data structure of all unsigned 24-bit SPI_master CHANNEL FRAME data (meant to be accessed via PSE mirror)*/
@@ -259,17 +429,33 @@ typedef struct
 	/* 0x0008 */
 	etpu_if_uint32				_data_in_reg;
 	/* 0x000c */
-	etpu_if_uint32 : 32;
+	etpu_if_uint32				_slave_select_chan_pack;
 	/* 0x0010 */
 	etpu_if_uint32 : 32;
 	/* 0x0014 */
-	etpu_if_uint32 : 32;
+	etpu_if_uint32				_angle_table;
 	/* 0x0018 */
-	etpu_if_uint32 : 32;
+	etpu_if_uint32				_crc;
 	/* 0x001c */
+	etpu_if_uint32				_burst;
+	/* 0x0020 */
+	etpu_if_uint32				_chain;
+	/* 0x0024 */
+	etpu_if_uint32				_stream;
+	/* 0x0028 */
+	etpu_if_uint32				_counters;
+	/* 0x002c */
+	etpu_if_uint32 : 32;
+	/* 0x0030 */
+	etpu_if_uint32				_attach_sum;
+	/* 0x0034 */
+	etpu_if_uint32 : 32;
+	/* 0x0038 */
+	etpu_if_uint32 : 32;
+	/* 0x003c */
 	etpu_if_uint32 : 32;
 } etpu_if_SPI_master_CHANNEL_FRAME_unsignedPSE;
-#define etpu_if_SPI_master_CHANNEL_FRAME_unsignedPSE_EXPECTED_SIZE 32
+#define etpu_if_SPI_master_CHANNEL_FRAME_unsignedPSE_EXPECTED_SIZE 64
 
 
 #endif /* __etpu_set_struct_H */
@@ -0,0 +1,102 @@
+/*******************************************************************************
+*
+* Copyright (C) 2020 ASH WARE, Inc.
+*
+****************************************************************************//*!
+*
+* @file    etpu_code_rle_gen.c
+*
+* @brief   Build host tool - writes etpu_set_scm_rle.h, the run-length
+*          compressed image of etpu_set_scm.h that fs_etpu_init_rle_ext
+*          loads, as a const array initializer for flash.
+*
+*          Run after every ETEC build of the eTPU code, e.g. from this
+*          directory:
+*            cc -I../_etpu_set -o etpu_code_rle_gen etpu_code_rle_gen.c
+*            ./etpu_code_rle_gen > ../_etpu_set/etpu_set_scm_rle.h
+*
+*          The image format is described with FS_ETPU_CODE_RLE_MAGIC in
+*          etpu_util_ext.h, the compression is that of
+*          fs_etpu_code_rle_compress_ext.  The output refuses to build
+*          against any other eTPU code (_MISC_VALUE_ check).
+*
+*******************************************************************************/
+#include <stdio.h>
+
+#include "etpu_set_defines.h"
+
+#define FS_ETPU_CODE_RLE_MAGIC      0x524C4531 /* "RLE1" */
+#define FS_ETPU_CODE_RLE_RUN        0x80000000 /* control word run flag */
+#define FS_ETPU_CODE_RLE_RUN_MIN    3          /* shorter runs stay literal */
+
+static const unsigned long etpu_code[] = {
+#include "etpu_set_scm.h"
+};
+
+#define CODE_CNT (sizeof(etpu_code) / sizeof(etpu_code[0]))
+
+static unsigned long rle_code[3 + 2 * CODE_CNT];
+
+/* as fs_etpu_checksum_ext */
+static unsigned long checksum(const unsigned long *p_data, unsigned long cnt)
+{
+  unsigned long sum = 0;
+
+  while(cnt--)
+  {
+    sum = (((sum << 1) | (sum >> 31)) + *p_data++) & 0xFFFFFFFFUL;
+  }
+  return(sum);
+}
+
+int main(void)
+{
+  unsigned long cnt = 0;
+  unsigned long q = 0;
+  unsigned long ctrl = 0;
+  unsigned long run;
+  unsigned long i;
+
+  rle_code[cnt++] = FS_ETPU_CODE_RLE_MAGIC;
+  rle_code[cnt++] = CODE_CNT * 4;
+  rle_code[cnt++] = checksum(etpu_code, CODE_CNT);
+
+  while(q < CODE_CNT)
+  {
+    for(run = 1; (q + run < CODE_CNT) && (etpu_code[q + run] == etpu_code[q]); run++);
+    if(run >= FS_ETPU_CODE_RLE_RUN_MIN)
+    {
+      rle_code[cnt++] = FS_ETPU_CODE_RLE_RUN | run;
+      rle_code[cnt++] = etpu_code[q];
+      q += run;
+      ctrl = 0;
+    }
+    else
+    {
+      /* extend the open literal record, or start one */
+      if(ctrl == 0)
+      {
+        ctrl = cnt++;
+        rle_code[ctrl] = 0;
+      }
+      rle_code[cnt++] = etpu_code[q++];
+      rle_code[ctrl]++;
+    }
+  }
+
+  printf("// This file is generated by etpu_code_rle_gen from etpu_set_scm.h.\n");
+  printf("//    !!!   DO NOT EDIT THIS FILE   !!!\n\n");
+  printf("// SCM run-length compressed for fs_etpu_init_rle_ext, %lu of %lu bytes\n",
+    cnt * 4, (unsigned long)CODE_CNT * 4);
+  printf("// Data packaged for inclusion into an array initializer\n");
+  printf("#if _MISC_VALUE_ != 0x%08lX\n", (unsigned long)_MISC_VALUE_);
+  printf("#error \"etpu_set_scm_rle.h is not of the current eTPU code - run etpu_code_rle_gen\"\n");
+  printf("#endif\n");
+  for(i = 0; i < cnt; i++)
+  {
+    if((i & 3) == 0) printf("/*0x%03lX*/", i * 4);
+    printf(" 0x%08lX,", rle_code[i]);
+    if(((i & 3) == 3) || (i == cnt - 1)) printf("\n");
+  }
+  return(0);
+}
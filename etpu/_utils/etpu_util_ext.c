@@ -29,11 +29,15 @@
 * The included routines can be divided into several groups by application usage:
 * -# eTPU Module Initialization
 *    - @ref fs_etpu_init
+*    - @ref fs_etpu_init_rle, @ref fs_etpu_code_rle_compress (compressed code image)
 *    - @ref fs_etpu2_init (eTPU2-only)
+*    - @ref fs_etpu_warm_init, @ref fs_etpu2_warm_init (re-attach after a host reset)
 * -# eTPU Channel Initialization
 *    - @ref fs_etpu_chan_init
 *    - @ref fs_etpu_malloc
 *    - @ref fs_etpu_malloc2
+*    - @ref fs_etpu_malloc_align, @ref fs_etpu_free, @ref fs_etpu_get_sdm_stats
+*    - @ref fs_etpu_claim
 * -# Run-Time eTPU Module Control
 *    - @ref fs_timer_start
 *    - @ref fs_etpu_get_global_exceptions, @ref fs_etpu_clear_global_exceptions
@@ -56,11 +60,15 @@
 *    - @ref fs_etpu_set_global_32, @ref fs_etpu_set_global_24, @ref fs_etpu_set_global_16, @ref fs_etpu_set_global_8
 *    - @ref fs_etpu_coherent_read_32, @ref fs_etpu_coherent_read_24
 *    - @ref fs_etpu_coherent_write_32, @ref fs_etpu_coherent_write_24
+* -# Module Handle (resolved once, used by the hot paths)
+*    - @ref fs_etpu_module_ext
+*    - the _mod versions of the channel control, DATA RAM access and
+*      allocation functions above (the DATA RAM accessors inline)
 * -# eTPU Load Evaluation
 *    - @ref fs_etpu_get_idle_cnt_a, @ref fs_etpu_clear_idle_cnt_a (eTPU2-only)
 *    - @ref fs_etpu_get_idle_cnt_b, @ref fs_etpu_clear_idle_cnt_b (eTPU2-only)
 * -# Others
-*    - @ref fs_memcpy32, @ref fs_memset32
+*    - @ref fs_etpu_checksum, @ref fs_memcpy32, @ref fs_memset32
 *
 *******************************************************************************/
 /*******************************************************************************
@@ -71,44 +79,176 @@
 extern const uint32_t fs_etpu_code_start;
 extern const uint32_t fs_etpu_c_code_start;
 
+/* module handles, resolved on the first fs_etpu_module_ext call */
+static struct etpu_module_t fs_etpu_module[2];
+static struct etpu_sdm_heap_t fs_etpu_sdm_heap[2];
+
 /*******************************************************************************
-* FUNCTION: fs_etpu_init_ext
+* FUNCTION: fs_etpu_module_ext
 ****************************************************************************//*!
-* @brief   This function initializes the eTPU module.
-*
-* @note    The following actions are performed in order:
-*          -# Load eTPU code into code RAM
-*          -# Initialize global registers:
-*             - Module Control Register
-*             - MISC value
-*             - Engine Control Registers
-*             - TCR pre-scalers
-*          -# Copy initial values of global variables to data RAM
+* @brief   This function returns the handle of an eTPU module, to be passed
+*          to the _mod functions.
 *
-* @param   p_etpu_config - This is the structure used to initialize the eTPU
-* @param   *code - This is a pointer to an image of the eTPU code.
-* @param   code_size - This is the size of the eTPU code in bytes.
-* @param   *globals - This is a pointer to the global eTPU data that needs
-*          to be initialized.
-* @param   globals_size - This is the size of the global data in bytes.
+* @note    The handle holds the engine register base, the DATA RAM bounds and
+*          the free_param reference, so the _mod functions do not resolve the
+*          module on each call. It is resolved once and stays valid.
 *
-* @return  Zero or an error code. Error codes that can be returned are:
-*          - @ref FS_ETPU_ERROR_CODESIZE - When the code is too big for the
-*            available memory
-*          - @ref FS_ETPU_ERROR_VIS_BIT_NOT_SET - When the SCM Visibility cannot
-*            be set and SCM cannot be written.
+* @param   em - The eTPU module (EM_AB or EM_C)
 *
-* @warning This function does not configure the pins, only the eTPU.
+* @return  A pointer to the module handle.
 *******************************************************************************/
-uint32_t fs_etpu_init_ext(
+const struct etpu_module_t *fs_etpu_module_ext(
+  ETPU_MODULE em)
+{
+  struct etpu_module_t *p_mod;
+
+  switch (em)
+  {
+  case EM_AB:
+  default:
+	  p_mod = &fs_etpu_module[0];
+	  if(p_mod->etpu == 0)
+	  {
+	    p_mod->data_ram_start = fs_etpu_data_ram_start;
+	    p_mod->data_ram_end = fs_etpu_data_ram_end;
+	    p_mod->data_ram_ext = fs_etpu_data_ram_ext;
+	    p_mod->free_param = &fs_etpu_free_param;
+	    p_mod->heap = &fs_etpu_sdm_heap[0];
+	    p_mod->etpu = eTPU_AB;
+	  }
+	  break;
+  case EM_C:
+	  p_mod = &fs_etpu_module[1];
+	  if(p_mod->etpu == 0)
+	  {
+	    p_mod->data_ram_start = fs_etpu_c_data_ram_start;
+	    p_mod->data_ram_end = fs_etpu_c_data_ram_end;
+	    p_mod->data_ram_ext = fs_etpu_c_data_ram_ext;
+	    p_mod->free_param = &fs_etpu_c_free_param;
+	    p_mod->heap = &fs_etpu_sdm_heap[1];
+	    p_mod->etpu = eTPU_C;
+	  }
+	  break;
+  }
+
+  return(p_mod);
+}
+
+/* DATA RAM heap helpers */
+/* the heap starts at free_param when first used (after fs_etpu2_init has
+   taken the engine memory) */
+static struct etpu_sdm_heap_t *fs_etpu_sdm_heap_get(
+  const struct etpu_module_t *p_mod)
+{
+  struct etpu_sdm_heap_t *heap = p_mod->heap;
+
+  if(heap->base == 0)
+  {
+    heap->base = (uint32_t)*p_mod->free_param;
+  }
+  return(heap);
+}
+
+static void fs_etpu_sdm_heap_reset(
+  struct etpu_sdm_heap_t *heap)
+{
+  heap->base = 0;
+  heap->free_bytes = 0;
+  heap->peak_bytes = 0;
+  heap->fail_cnt = 0;
+  heap->free_cnt = 0;
+}
+
+/* first address from start the block can take - with FS_ETPU_MALLOC_CDC it
+   must not cross a CDC window */
+static uint32_t fs_etpu_sdm_fit(
+  const struct etpu_module_t *p_mod,
+  uint32_t start,
+  uint32_t size,
+  uint8_t flags)
+{
+  uint32_t offset = start - p_mod->data_ram_start;
+
+  if((flags & FS_ETPU_MALLOC_CDC) && (size != 0) &&
+     ((offset / FS_ETPU_SDM_CDC_WINDOW) != ((offset + size - 1) / FS_ETPU_SDM_CDC_WINDOW)))
+  {
+    offset = ((offset + FS_ETPU_SDM_CDC_WINDOW - 1) / FS_ETPU_SDM_CDC_WINDOW) * FS_ETPU_SDM_CDC_WINDOW;
+  }
+  return(p_mod->data_ram_start + offset);
+}
+
+static void fs_etpu_sdm_remove(
+  struct etpu_sdm_heap_t *heap,
+  uint16_t i)
+{
+  heap->free_cnt--;
+  for(; i < heap->free_cnt; i++)
+  {
+    heap->free_list[i] = heap->free_list[i+1];
+  }
+}
+
+/* the caller checks there is an entry left */
+static void fs_etpu_sdm_insert(
+  struct etpu_sdm_heap_t *heap,
+  uint16_t i,
+  uint32_t start,
+  uint32_t size)
+{
+  uint16_t j;
+
+  for(j = heap->free_cnt; j > i; j--)
+  {
+    heap->free_list[j] = heap->free_list[j-1];
+  }
+  heap->free_list[i].start = start;
+  heap->free_list[i].size = size;
+  heap->free_cnt++;
+}
+
+/* expand RLE records from src to dest, NULL if they overrun either end */
+static uint32_t *fs_etpu_code_rle_expand(
+  uint32_t *dest,
+  uint32_t *dest_end,
+  uint32_t *src,
+  uint32_t *src_end)
+{
+  uint32_t ctrl;
+  uint32_t cnt;
+
+  while(src < src_end)
+  {
+    ctrl = *src++;
+    cnt = ctrl & ~FS_ETPU_CODE_RLE_RUN;
+    if(cnt > (uint32_t)(dest_end - dest)) return(0);
+    if(ctrl & FS_ETPU_CODE_RLE_RUN)
+    {
+      if(src >= src_end) return(0);
+      fs_memset32_ext(dest, *src++, cnt << 2);
+      dest += cnt;
+    }
+    else
+    {
+      if(cnt > (uint32_t)(src_end - src)) return(0);
+      dest = fs_memcpy32_ext(dest, src, cnt << 2);
+      src += cnt;
+    }
+  }
+  return(dest);
+}
+
+/* fs_etpu_init_ext and fs_etpu_init_rle_ext - rle selects the image format */
+static uint32_t fs_etpu_init_load(
   ETPU_MODULE em,
   struct etpu_config_t *p_etpu_config,
   uint32_t *code,
   uint32_t code_size,
   uint32_t *globals,
-  uint32_t globals_size)
+  uint32_t globals_size,
+  uint8_t rle)
 {
   uint32_t *code_end;
+  uint32_t image_size;
   int32_t unused_code_ram;
   int8_t x;
   volatile struct eTPU_struct * eTPU;
@@ -133,7 +273,17 @@ uint32_t fs_etpu_init_ext(
 	  break;
   }
 
-  unused_code_ram = ((eTPU->MCR.B.SCMSIZE + 1 ) * 2048) - code_size;
+  image_size = code_size;
+  if(rle)
+  {
+    /* the header gives the size and checksum of the expanded image */
+    if((code_size < FS_ETPU_CODE_RLE_HEADER_CNT * sizeof(uint32_t)) ||
+       (code[0] != FS_ETPU_CODE_RLE_MAGIC))
+      return(FS_ETPU_ERROR_VALUE);
+    image_size = code[1];
+  }
+
+  unused_code_ram = ((eTPU->MCR.B.SCMSIZE + 1 ) * 2048) - image_size;
   if(unused_code_ram < 0) return((uint32_t)FS_ETPU_ERROR_CODESIZE);
 
   /* 1. Load microcode */
@@ -152,8 +302,25 @@ uint32_t fs_etpu_init_ext(
 
   if(x > 4) return (FS_ETPU_ERROR_VIS_BIT_NOT_SET);
 
-  /* Copy microcode */
-  code_end = fs_memcpy32_ext((uint32_t*)code_start, code, code_size);
+  if(rle)
+  {
+    /* Expand microcode straight into code memory, then verify it there -
+     * on a bad image the engines stay stopped */
+    code_end = fs_etpu_code_rle_expand((uint32_t*)code_start,
+      (uint32_t*)(code_start + image_size),
+      code + FS_ETPU_CODE_RLE_HEADER_CNT, code + (code_size >> 2));
+    if((code_end != (uint32_t*)(code_start + image_size)) ||
+       (fs_etpu_checksum_ext((uint32_t*)code_start, image_size) != code[2]))
+    {
+      eTPU->MCR.B.VIS = 0;
+      return(FS_ETPU_ERROR_CHECKSUM);
+    }
+  }
+  else
+  {
+    /* Copy microcode */
+    code_end = fs_memcpy32_ext((uint32_t*)code_start, code, code_size);
+  }
 
   /* Clear rest of program memory */
   fs_memset32_ext(code_end, 0, unused_code_ram);
@@ -188,9 +355,162 @@ uint32_t fs_etpu_init_ext(
   *free_param = fs_memcpy32_ext((uint32_t*)data_ram_start, globals, globals_size);
   *free_param = (uint32_t*)((((uint32_t)*free_param + 7) >> 3) << 3); /* round up to 8s */
 
+  /* anything allocated before is gone */
+  fs_etpu_sdm_heap_reset(fs_etpu_module_ext(em)->heap);
+
   return(0);
 }
 
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_init_ext
+****************************************************************************//*!
+* @brief   This function initializes the eTPU module.
+*
+* @note    The following actions are performed in order:
+*          -# Load eTPU code into code RAM
+*          -# Initialize global registers:
+*             - Module Control Register
+*             - MISC value
+*             - Engine Control Registers
+*             - TCR pre-scalers
+*          -# Copy initial values of global variables to data RAM
+*
+* @param   p_etpu_config - This is the structure used to initialize the eTPU
+* @param   *code - This is a pointer to an image of the eTPU code.
+* @param   code_size - This is the size of the eTPU code in bytes.
+* @param   *globals - This is a pointer to the global eTPU data that needs
+*          to be initialized.
+* @param   globals_size - This is the size of the global data in bytes.
+*
+* @return  Zero or an error code. Error codes that can be returned are:
+*          - @ref FS_ETPU_ERROR_CODESIZE - When the code is too big for the
+*            available memory
+*          - @ref FS_ETPU_ERROR_VIS_BIT_NOT_SET - When the SCM Visibility cannot
+*            be set and SCM cannot be written.
+*
+* @warning This function does not configure the pins, only the eTPU.
+*******************************************************************************/
+uint32_t fs_etpu_init_ext(
+  ETPU_MODULE em,
+  struct etpu_config_t *p_etpu_config,
+  uint32_t *code,
+  uint32_t code_size,
+  uint32_t *globals,
+  uint32_t globals_size)
+{
+  return(fs_etpu_init_load(em, p_etpu_config, code, code_size,
+    globals, globals_size, 0));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_init_rle_ext
+****************************************************************************//*!
+* @brief   This function initializes the eTPU module from a run-length
+*          compressed code image, as fs_etpu_init_ext does from a raw one.
+*
+* @note    The image is expanded straight into code memory, so only the
+*          compressed words are read from flash.  The expanded code is then
+*          read back and checked against the image checksum before the
+*          engines are configured.
+*
+* @param   p_etpu_config - This is the structure used to initialize the eTPU
+* @param   *rle_code - This is a pointer to an image made by
+*          @ref fs_etpu_code_rle_compress_ext.
+* @param   rle_code_size - This is the size of the compressed image in bytes.
+* @param   *globals - This is a pointer to the global eTPU data that needs
+*          to be initialized.
+* @param   globals_size - This is the size of the global data in bytes.
+*
+* @return  Zero or an error code. Error codes that can be returned are:
+*          - @ref FS_ETPU_ERROR_VALUE - When the image header is not valid
+*          - @ref FS_ETPU_ERROR_CODESIZE - When the code is too big for the
+*            available memory
+*          - @ref FS_ETPU_ERROR_VIS_BIT_NOT_SET - When the SCM Visibility cannot
+*            be set and SCM cannot be written.
+*          - @ref FS_ETPU_ERROR_CHECKSUM - When the image is corrupt or the
+*            code memory does not read back as written.  The engines are left
+*            stopped.
+*
+* @warning This function does not configure the pins, only the eTPU.
+*******************************************************************************/
+uint32_t fs_etpu_init_rle_ext(
+  ETPU_MODULE em,
+  struct etpu_config_t *p_etpu_config,
+  uint32_t *rle_code,
+  uint32_t rle_code_size,
+  uint32_t *globals,
+  uint32_t globals_size)
+{
+  return(fs_etpu_init_load(em, p_etpu_config, rle_code, rle_code_size,
+    globals, globals_size, 1));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_code_rle_compress_ext
+****************************************************************************//*!
+* @brief   This function makes the run-length compressed image of an eTPU
+*          code image that @ref fs_etpu_init_rle_ext loads.
+*
+* @note    Meant for the build host or a one-off target run; store the
+*          result in flash in place of the raw image.  Repeats of at least
+*          FS_ETPU_CODE_RLE_RUN_MIN words (the unused entry table vectors,
+*          the cleared code end) become 2-word runs.
+*
+* @param   *rle_code - The pointer to the compressed image buffer
+* @param   rle_code_size - The size of the buffer in bytes
+* @param   *code - This is a pointer to an image of the eTPU code.
+* @param   code_size - This is the size of the eTPU code in bytes.
+*
+* @return  The size of the compressed image in bytes, or 0 when it does not
+*          fit the buffer.
+*******************************************************************************/
+uint32_t fs_etpu_code_rle_compress_ext(
+  uint32_t *rle_code,
+  uint32_t rle_code_size,
+  uint32_t *code,
+  uint32_t code_size)
+{
+  uint32_t *p = rle_code;
+  uint32_t *p_end = rle_code + (rle_code_size >> 2);
+  uint32_t *q = code;
+  uint32_t *q_end = code + (code_size >> 2);
+  uint32_t *p_ctrl = 0;
+  uint32_t run;
+
+  if(rle_code_size < FS_ETPU_CODE_RLE_HEADER_CNT * sizeof(uint32_t)) return(0);
+  *p++ = FS_ETPU_CODE_RLE_MAGIC;
+  *p++ = code_size & ~3;
+  *p++ = fs_etpu_checksum_ext(code, code_size);
+
+  while(q < q_end)
+  {
+    for(run = 1; (q + run < q_end) && (q[run] == q[0]); run++);
+    if(run >= FS_ETPU_CODE_RLE_RUN_MIN)
+    {
+      if(p_end - p < 2) return(0);
+      *p++ = FS_ETPU_CODE_RLE_RUN | run;
+      *p++ = *q;
+      q += run;
+      p_ctrl = 0;
+    }
+    else
+    {
+      /* extend the open literal record, or start one */
+      if(p_ctrl == 0)
+      {
+        if(p >= p_end) return(0);
+        p_ctrl = p++;
+        *p_ctrl = 0;
+      }
+      if(p >= p_end) return(0);
+      *p++ = *q++;
+      (*p_ctrl)++;
+    }
+  }
+  return((uint32_t)(p - rle_code) << 2);
+}
+
 /*******************************************************************************
 * FUNCTION: fs_etpu2_init_ext
 ****************************************************************************//*!
@@ -274,6 +594,140 @@ uint32_t fs_etpu2_init_ext(
     return(0);
 }
 
+/*******************************************************************************
+* FUNCTION: fs_etpu_warm_init_ext
+****************************************************************************//*!
+* @brief   This function re-attaches to an eTPU module that kept running
+*          through a host reset, in place of @ref fs_etpu_init_ext.  Code,
+*          globals and channels keep running; only VIS is set, for the code
+*          memory read back.
+*
+* @note    The following checks are performed, any failing means a cold
+*          start (fs_etpu_init_ext) is needed:
+*          - code memory is not open to the host (VIS) and has no read error
+*          - engine A runs with the configured entry table base
+*          - no illegal instruction was flagged
+*          - the MISC compare value is the one of this code build, and with
+*            MISC enabled, the hardware signature check of the code memory
+*            has not failed
+*          - the code memory reads back with the checksum of the build -
+*            this holds with MISC disabled too
+*          Then the DATA RAM allocator is restarted empty above the globals;
+*          drivers claim their memory again (@ref fs_etpu_claim_ext) as they
+*          re-attach their instances.
+*
+* @param   p_etpu_config - The structure the module was initialized with
+* @param   code_size - This is the size of the eTPU code in bytes.
+* @param   code_checksum - The @ref fs_etpu_checksum_ext of the eTPU code,
+*          e.g. FS_ETPU_CODE_RLE_CHECKSUM of its compressed image.
+* @param   globals_size - This is the size of the global data in bytes.
+*
+* @return  Zero or an error code. Error codes that can be returned are:
+*          - @ref FS_ETPU_ERROR_CHECKSUM - When the module does not run the
+*            expected code.
+*          - @ref FS_ETPU_ERROR_VIS_BIT_NOT_SET - When the code memory could
+*            not be opened for the read back.
+*
+* @warning On eTPU2, follow with @ref fs_etpu2_warm_init_ext.
+*******************************************************************************/
+uint32_t fs_etpu_warm_init_ext(
+  ETPU_MODULE em,
+  struct etpu_config_t *p_etpu_config,
+  uint32_t code_size,
+  uint32_t code_checksum,
+  uint32_t globals_size)
+{
+  const struct etpu_module_t *p_mod = fs_etpu_module_ext(em);
+  volatile struct eTPU_struct * eTPU = p_mod->etpu;
+  uint32_t code_start;
+  uint32_t sum;
+  int8_t x;
+
+  if((eTPU->MCR.B.VIS != 0) ||
+     (eTPU->MCR.B.SCMERR != 0) ||
+     (eTPU->MCR.B.ILF1 != 0) || (eTPU->MCR.B.ILF2 != 0) ||
+     (eTPU->ECR_A.B.MDIS != 0) ||
+     (eTPU->ECR_A.B.ETB != (p_etpu_config->ecr_a & FS_ETPU_ENTRY_TABLE_BASE_MASK)) ||
+     (eTPU->MISCCMPR.R != p_etpu_config->misc) ||
+     ((eTPU->MCR.B.SCMMISEN != 0) && (eTPU->MCR.B.SCMMISF != 0)) ||
+     (code_size > (uint32_t)((eTPU->MCR.B.SCMSIZE + 1) * 2048)))
+  {
+    return(FS_ETPU_ERROR_CHECKSUM);
+  }
+
+  /* read the code memory back */
+  code_start = (em == EM_C) ? fs_etpu_c_code_start : fs_etpu_code_start;
+  eTPU->MCR.B.VIS = 1;
+  x = 0;
+  while(x < 5)
+  {
+    if(eTPU->MCR.B.VIS == 1) break;
+    x++;
+  }
+  if(x > 4) return (FS_ETPU_ERROR_VIS_BIT_NOT_SET);
+  sum = fs_etpu_checksum_ext((uint32_t*)code_start, code_size);
+  eTPU->MCR.B.VIS = 0;
+  if(sum != code_checksum) return(FS_ETPU_ERROR_CHECKSUM);
+
+  /* the heap restarts where fs_etpu_init_ext left it */
+  *p_mod->free_param = (uint32_t*)((((p_mod->data_ram_start + globals_size) + 7) >> 3) << 3);
+  fs_etpu_sdm_heap_reset(p_mod->heap);
+
+  return(0);
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu2_warm_init_ext
+****************************************************************************//*!
+* @brief   This function re-attaches to the eTPU2-only settings of a running
+*          eTPU2 module, in place of @ref fs_etpu2_init_ext - the engine-
+*          relative data memory is taken back as fs_etpu2_init_ext placed
+*          it, below the heap, so the heap statistics are those of a cold
+*          start.
+*
+* @param   engine_mem_size - This is the size of the engine relative data
+*          in bytes, as given to fs_etpu2_init_ext.
+*
+* @return  Zero or an error code. Error code that can be returned is:
+*          - @ref FS_ETPU_ERROR_CHECKSUM - When ERBA of an engine is not where
+*            fs_etpu2_init_ext puts it.
+*
+* @warning This function is applicable to eTPU2 only. Call it right after
+*          @ref fs_etpu_warm_init_ext, before any allocation.
+*******************************************************************************/
+uint32_t fs_etpu2_warm_init_ext(
+  ETPU_MODULE em,
+  uint32_t engine_mem_size)
+{
+  const struct etpu_module_t *p_mod = fs_etpu_module_ext(em);
+  volatile struct eTPU_struct * eTPU = p_mod->etpu;
+  uint32_t **free_param = p_mod->free_param;
+
+  /* as fs_etpu2_init_ext allocates */
+  if(engine_mem_size > 0)
+  {
+    /* Engine A */
+    if(eTPU->ECR_A.B.MDIS == 0)
+    {
+      *free_param = (uint32_t*)((((uint32_t)*free_param+511)>>9)<<9); /* round up to 512s */
+      if((uint32_t)eTPU->ECR_A.B.ERBA != ((((uint32_t)*free_param) >> 9) & 0x1f))
+        return(FS_ETPU_ERROR_CHECKSUM);
+      *free_param = (uint32_t*)((uint32_t)*free_param + engine_mem_size);
+    }
+    /* Engine B */
+    if(eTPU->ECR_B.B.MDIS == 0)
+    {
+      *free_param = (uint32_t*)((((uint32_t)*free_param+511)>>9)<<9); /* round up to 512s */
+      if((uint32_t)eTPU->ECR_B.B.ERBA != ((((uint32_t)*free_param) >> 9) & 0x1f))
+        return(FS_ETPU_ERROR_CHECKSUM);
+      *free_param = (uint32_t*)((uint32_t)*free_param + engine_mem_size);
+    }
+  }
+  *free_param = (uint32_t*)((((uint32_t)*free_param + 7) >> 3) << 3); /* round up to 8s */
+
+  return(0);
+}
+
 /*******************************************************************************
 * FUNCTION: fs_etpu_chan_init_ext
 ****************************************************************************//*!
@@ -352,23 +806,7 @@ uint32_t *fs_etpu_get_cpba_ext(
   ETPU_MODULE em,
   uint8_t channel)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return((uint32_t*)((uint8_t*)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA << 3)));
+  return(fs_etpu_get_cpba_mod(fs_etpu_module_ext(em), channel));
 }
 
 /*******************************************************************************
@@ -388,24 +826,8 @@ uint32_t *fs_etpu_get_cpba_pse_ext(
   ETPU_MODULE em,
   uint8_t channel)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start_pse;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start_pse = fs_etpu_data_ram_ext;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start_pse = fs_etpu_c_data_ram_ext;
-	  break;
-  }
-
-  return((uint32_t*)((uint8_t*)data_ram_start_pse + (eTPU->CHAN[channel].CR.B.CPBA << 3)));
-}
+  return(fs_etpu_get_cpba_pse_mod(fs_etpu_module_ext(em), channel));
+}
 
 
 /*******************************************************************************
@@ -426,20 +848,7 @@ void fs_etpu_set_hsr_ext(
   uint8_t channel,
   uint8_t hsr)
 {
-  volatile struct eTPU_struct * eTPU;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  break;
-  }
-
-  eTPU->CHAN[channel].HSRR.R = hsr;
+  fs_etpu_set_hsr_mod(fs_etpu_module_ext(em), channel, hsr);
 }
 
 /*******************************************************************************
@@ -456,20 +865,7 @@ uint8_t fs_etpu_get_hsr_ext(
   ETPU_MODULE em,
   uint8_t channel)
 {
-  volatile struct eTPU_struct * eTPU;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  break;
-  }
-
-  return((uint8_t)eTPU->CHAN[channel].HSRR.R);
+  return(fs_etpu_get_hsr_mod(fs_etpu_module_ext(em), channel));
 }
 
 /*******************************************************************************
@@ -696,6 +1092,9 @@ void fs_timer_start_ext(
 * @return  A pointer to allocated DATA RAM. If the requested amount of memory
 *          is larger than the available amount of memory then 0 is returned.
 *
+* @note    A block released by @ref fs_etpu_free_ext is reused if it fits
+*          (best fit), otherwise the memory is taken from the top.
+*
 * @warning This function is non-reentrant and uses the @ref fs_free_param global.
 *          The granularity of eTPU DATA RAM allocation for channel parameters
 *          is 8 bytes. The requested size is enlarged to a multiple of 8 bytes.
@@ -704,30 +1103,21 @@ uint32_t *fs_etpu_malloc_ext(
   ETPU_MODULE em,
   uint16_t num_bytes)
 {
-  uint32_t *pba;
-  uint32_t data_ram_end;
-  uint32_t **free_param;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_end = fs_etpu_data_ram_end;
-	  free_param = &fs_etpu_free_param;
-	  break;
-  case EM_C:
-	  data_ram_end = fs_etpu_c_data_ram_end;
-	  free_param = &fs_etpu_c_free_param;
-	  break;
-  }
-
-  pba = *free_param;
-  *free_param += (((num_bytes+7)>>3)<<1);
+  return(fs_etpu_malloc_mod(fs_etpu_module_ext(em), num_bytes));
+}
 
-  if(*free_param > (uint32_t *)data_ram_end)
-    return(0);
-  else
-    return(pba);
+/*******************************************************************************
+* FUNCTION: fs_etpu_malloc_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_malloc_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t *fs_etpu_malloc_mod(
+  const struct etpu_module_t *p_mod,
+  uint16_t num_bytes)
+{
+  return(fs_etpu_malloc_align_mod(p_mod, num_bytes, 0));
 }
 
 /*******************************************************************************
@@ -756,40 +1146,432 @@ uint32_t *fs_etpu_malloc2_ext(
   uint8_t channel,
   uint16_t num_bytes)
 {
-  uint32_t *pba;
+  return(fs_etpu_malloc2_mod(fs_etpu_module_ext(em), channel, num_bytes));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_malloc2_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_malloc2_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t *fs_etpu_malloc2_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint16_t num_bytes)
+{
   volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_end;
-  uint32_t **free_param;
 
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_end = fs_etpu_data_ram_end;
-	  free_param = &fs_etpu_free_param;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_end = fs_etpu_c_data_ram_end;
-	  free_param = &fs_etpu_c_free_param;
-	  break;
-  }
+  eTPU = p_mod->etpu;
 
   if(eTPU->CHAN[channel].CR.B.CPBA == 0)
   {
-    pba = *free_param;
-    *free_param += (((num_bytes+7)>>3)<<1);
+    return(fs_etpu_malloc_mod(p_mod, num_bytes));
+  }
+  else
+  {
+    return(fs_etpu_get_cpba_mod(p_mod, channel));
+  }
+}
 
-    if(*free_param > (uint32_t *)data_ram_end)
-      return(0);
+/*******************************************************************************
+* FUNCTION: fs_etpu_malloc_align_ext
+****************************************************************************//*!
+* @brief   This function allocates DATA RAM, with placement constraints.
+*
+* @note    The smallest free block the request fits in is used (best fit),
+*          otherwise the memory is taken from the top. With
+*          @ref FS_ETPU_MALLOC_CDC the block does not cross a
+*          @ref FS_ETPU_SDM_CDC_WINDOW boundary, so any two parameters in it
+*          can be accessed by the coherent read/write functions. A gap left
+*          below an aligned block stays free.
+*
+* @param   num_bytes - this is the number of bytes that is required to
+*          allocate in DATA RAM.
+* @param   flags - 0 or @ref FS_ETPU_MALLOC_CDC
+*
+* @return  A pointer to allocated DATA RAM. If the requested amount of memory
+*          is not available then 0 is returned.
+*
+* @warning This function is non-reentrant. The granularity of eTPU DATA RAM
+*          allocation is 8 bytes. The requested size is enlarged to a multiple
+*          of 8 bytes.
+*******************************************************************************/
+uint32_t *fs_etpu_malloc_align_ext(
+  ETPU_MODULE em,
+  uint16_t num_bytes,
+  uint8_t flags)
+{
+  return(fs_etpu_malloc_align_mod(fs_etpu_module_ext(em), num_bytes, flags));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_malloc_align_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_malloc_align_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t *fs_etpu_malloc_align_mod(
+  const struct etpu_module_t *p_mod,
+  uint16_t num_bytes,
+  uint8_t flags)
+{
+  struct etpu_sdm_heap_t *heap;
+  struct etpu_sdm_block_t *blk;
+  uint32_t size;
+  uint32_t start;
+  uint32_t top;
+  uint32_t used;
+  int16_t best;
+  uint16_t i;
+
+  heap = fs_etpu_sdm_heap_get(p_mod);
+  size = ((uint32_t)(num_bytes+7)>>3)<<3;
+  top = (uint32_t)*p_mod->free_param;
+
+  /* best fit - the smallest free block that holds it */
+  best = -1;
+  for(i = 0; (size != 0) && (i < heap->free_cnt); i++)
+  {
+    blk = &heap->free_list[i];
+    start = fs_etpu_sdm_fit(p_mod, blk->start, size, flags);
+    if((start + size <= blk->start + blk->size) &&
+       ((best < 0) || (blk->size < heap->free_list[best].size)))
+    {
+      /* a block split in three needs one more entry */
+      if((start == blk->start) || (start + size == blk->start + blk->size) ||
+         (heap->free_cnt < FS_ETPU_SDM_FREE_BLOCK_CNT))
+      {
+        best = (int16_t)i;
+      }
+    }
+  }
+
+  if(best >= 0)
+  {
+    blk = &heap->free_list[best];
+    top = blk->start + blk->size;  /* end of the block */
+    i = (uint16_t)best;
+    start = fs_etpu_sdm_fit(p_mod, blk->start, size, flags);
+    if(start > blk->start)
+    {
+      /* the gap below stays free */
+      blk->size = start - blk->start;
+      i++;
+    }
     else
-      return(pba);
+    {
+      fs_etpu_sdm_remove(heap, i);
+    }
+    if(start + size < top)
+    {
+      fs_etpu_sdm_insert(heap, i, start + size, top - (start + size));
+    }
+    heap->free_bytes -= size;
+  }
+  else
+  {
+    /* from the top */
+    start = fs_etpu_sdm_fit(p_mod, top, size, flags);
+    if((start + size > p_mod->data_ram_end) ||
+       ((start > top) && (heap->free_cnt >= FS_ETPU_SDM_FREE_BLOCK_CNT)))
+    {
+      heap->fail_cnt++;
+      return(0);
+    }
+    if(start > top)
+    {
+      /* the skipped gap is free, above all other free blocks */
+      fs_etpu_sdm_insert(heap, heap->free_cnt, top, start - top);
+      heap->free_bytes += start - top;
+    }
+    *p_mod->free_param = (uint32_t*)(start + size);
+  }
+
+  used = (uint32_t)*p_mod->free_param - heap->base - heap->free_bytes;
+  if(used > heap->peak_bytes)
+  {
+    heap->peak_bytes = used;
+  }
+  return((uint32_t*)start);
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_free_ext
+****************************************************************************//*!
+* @brief   This function releases DATA RAM allocated by @ref fs_etpu_malloc_ext,
+*          @ref fs_etpu_malloc2_ext or @ref fs_etpu_malloc_align_ext.
+*
+* @note    The block is merged with free neighbours. Memory released at the
+*          top lowers the top (free_param).
+*
+* @param   *p_mem - The (non-PSE) pointer that was returned by the allocation
+* @param   num_bytes - The number of bytes that was requested
+*
+* @return  Zero or an error code. Error codes that can be returned are:
+*          - @ref FS_ETPU_ERROR_ADDRESS - When the block is not allocated
+*            heap memory (outside the heap or overlapping a free block)
+*          - @ref FS_ETPU_ERROR_MALLOC - When the free list is full
+*            (@ref FS_ETPU_SDM_FREE_BLOCK_CNT) - the block stays allocated
+*
+* @warning This function is non-reentrant. No channel may still use the
+*          memory.
+*******************************************************************************/
+uint32_t fs_etpu_free_ext(
+  ETPU_MODULE em,
+  uint32_t *p_mem,
+  uint16_t num_bytes)
+{
+  return(fs_etpu_free_mod(fs_etpu_module_ext(em), p_mem, num_bytes));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_free_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_free_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t fs_etpu_free_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t *p_mem,
+  uint16_t num_bytes)
+{
+  struct etpu_sdm_heap_t *heap;
+  struct etpu_sdm_block_t *prev;
+  struct etpu_sdm_block_t *next;
+  uint32_t size;
+  uint32_t start;
+  uint32_t top;
+  uint16_t i;
+
+  heap = fs_etpu_sdm_heap_get(p_mod);
+  start = (uint32_t)p_mem;
+  size = ((uint32_t)(num_bytes+7)>>3)<<3;
+  top = (uint32_t)*p_mod->free_param;
+
+  if(((start & 7) != 0) || (start < heap->base) || (start + size > top))
+  {
+    return(FS_ETPU_ERROR_ADDRESS);
+  }
+  if(size == 0)
+  {
+    return(0);
+  }
+
+  /* free neighbours - the list is ordered by address */
+  for(i = 0; (i < heap->free_cnt) && (heap->free_list[i].start < start); i++)
+  {
+  }
+  prev = (i > 0) ? &heap->free_list[i-1] : 0;
+  next = (i < heap->free_cnt) ? &heap->free_list[i] : 0;
+  if(((prev != 0) && (prev->start + prev->size > start)) ||
+     ((next != 0) && (start + size > next->start)))
+  {
+    return(FS_ETPU_ERROR_ADDRESS);
+  }
+
+  if(start + size == top)
+  {
+    /* lower the top, taking a free block just below along */
+    if((prev != 0) && (prev->start + prev->size == start))
+    {
+      start = prev->start;
+      heap->free_bytes -= prev->size;
+      fs_etpu_sdm_remove(heap, i-1);
+    }
+    *p_mod->free_param = (uint32_t*)start;
+  }
+  else if((prev != 0) && (prev->start + prev->size == start))
+  {
+    prev->size += size;
+    heap->free_bytes += size;
+    if((next != 0) && (prev->start + prev->size == next->start))
+    {
+      prev->size += next->size;
+      fs_etpu_sdm_remove(heap, i);
+    }
+  }
+  else if((next != 0) && (start + size == next->start))
+  {
+    next->start = start;
+    next->size += size;
+    heap->free_bytes += size;
+  }
+  else
+  {
+    if(heap->free_cnt >= FS_ETPU_SDM_FREE_BLOCK_CNT)
+    {
+      return(FS_ETPU_ERROR_MALLOC);
+    }
+    fs_etpu_sdm_insert(heap, i, start, size);
+    heap->free_bytes += size;
+  }
+  return(0);
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_claim_ext
+****************************************************************************//*!
+* @brief   This function marks a DATA RAM block that is already in use as
+*          allocated - after @ref fs_etpu_warm_init_ext, each driver claims
+*          the frames and buffers of its running instances again.
+*
+* @note    Claims may come in any order.  A block above the top raises the
+*          top; the gap left below it is free (untracked if the free list is
+*          full, so not reused until the next cold start).
+*
+* @param   *p_mem - The (non-PSE) pointer to the block
+* @param   num_bytes - The number of bytes that was requested for it
+*
+* @return  Zero or an error code. Error code that can be returned is:
+*          - @ref FS_ETPU_ERROR_ADDRESS - When the block is outside the heap
+*            or overlaps a claimed one
+*          - @ref FS_ETPU_ERROR_MALLOC - When a split of a free block does not
+*            fit the free list (@ref FS_ETPU_SDM_FREE_BLOCK_CNT)
+*
+* @warning This function is non-reentrant.
+*******************************************************************************/
+uint32_t fs_etpu_claim_ext(
+  ETPU_MODULE em,
+  uint32_t *p_mem,
+  uint16_t num_bytes)
+{
+  return(fs_etpu_claim_mod(fs_etpu_module_ext(em), p_mem, num_bytes));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_claim_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_claim_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t fs_etpu_claim_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t *p_mem,
+  uint16_t num_bytes)
+{
+  struct etpu_sdm_heap_t *heap;
+  struct etpu_sdm_block_t *blk;
+  uint32_t size;
+  uint32_t start;
+  uint32_t end;
+  uint32_t top;
+  uint32_t used;
+  uint16_t i;
+
+  heap = fs_etpu_sdm_heap_get(p_mod);
+  start = (uint32_t)p_mem;
+  size = ((uint32_t)(num_bytes+7)>>3)<<3;
+  top = (uint32_t)*p_mod->free_param;
+
+  if(((start & 7) != 0) || (start < heap->base) || (start + size > p_mod->data_ram_end))
+  {
+    return(FS_ETPU_ERROR_ADDRESS);
+  }
+  if(size == 0)
+  {
+    return(0);
+  }
+
+  if(start >= top)
+  {
+    if((start > top) && (heap->free_cnt < FS_ETPU_SDM_FREE_BLOCK_CNT))
+    {
+      fs_etpu_sdm_insert(heap, heap->free_cnt, top, start - top);
+      heap->free_bytes += start - top;
+    }
+    *p_mod->free_param = (uint32_t*)(start + size);
   }
   else
   {
-    return(fs_etpu_get_cpba_ext(em, channel));
+    /* below the top it must lie in a free block */
+    for(i = 0; (i < heap->free_cnt) &&
+        (heap->free_list[i].start + heap->free_list[i].size <= start); i++)
+    {
+    }
+    blk = &heap->free_list[i];
+    if((i >= heap->free_cnt) || (blk->start > start) ||
+       (start + size > blk->start + blk->size))
+    {
+      return(FS_ETPU_ERROR_ADDRESS);
+    }
+    end = blk->start + blk->size;
+    if((start > blk->start) && (start + size < end) &&
+       (heap->free_cnt >= FS_ETPU_SDM_FREE_BLOCK_CNT))
+    {
+      return(FS_ETPU_ERROR_MALLOC);
+    }
+    if(start > blk->start)
+    {
+      blk->size = start - blk->start;
+      i++;
+    }
+    else
+    {
+      fs_etpu_sdm_remove(heap, i);
+    }
+    if(start + size < end)
+    {
+      fs_etpu_sdm_insert(heap, i, start + size, end - (start + size));
+    }
+    heap->free_bytes -= size;
+  }
+
+  used = (uint32_t)*p_mod->free_param - heap->base - heap->free_bytes;
+  if(used > heap->peak_bytes)
+  {
+    heap->peak_bytes = used;
   }
+  return(0);
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_get_sdm_stats_ext
+****************************************************************************//*!
+* @brief   This function returns the DATA RAM heap statistics.
+*
+* @note    The heap starts at free_param after the module initialization,
+*          so the globals and the eTPU2 engine memory are not included.
+*
+* @param   *p_stats - A pointer to where the statistics will be stored
+*******************************************************************************/
+void fs_etpu_get_sdm_stats_ext(
+  ETPU_MODULE em,
+  struct etpu_sdm_stats_t *p_stats)
+{
+  const struct etpu_module_t *p_mod;
+  struct etpu_sdm_heap_t *heap;
+  uint32_t top;
+  uint32_t largest;
+  uint16_t i;
+
+  p_mod = fs_etpu_module_ext(em);
+  heap = fs_etpu_sdm_heap_get(p_mod);
+  top = (uint32_t)*p_mod->free_param;
+
+  p_stats->total_bytes = p_mod->data_ram_end - heap->base;
+  p_stats->top_bytes = (p_mod->data_ram_end > top) ? (p_mod->data_ram_end - top) : 0;
+  p_stats->free_bytes = heap->free_bytes + p_stats->top_bytes;
+  p_stats->used_bytes = top - heap->base - heap->free_bytes;
+  p_stats->peak_bytes = heap->peak_bytes;
+  p_stats->free_block_cnt = heap->free_cnt;
+  p_stats->fail_cnt = heap->fail_cnt;
+
+  largest = p_stats->top_bytes;
+  for(i = 0; i < heap->free_cnt; i++)
+  {
+    if(heap->free_list[i].size > largest)
+    {
+      largest = heap->free_list[i].size;
+    }
+  }
+  p_stats->largest_free_bytes = largest;
+  p_stats->fragmentation = (p_stats->free_bytes == 0) ? 0 :
+    (uint8_t)(((p_stats->free_bytes - largest) * 100) / p_stats->free_bytes);
 }
 
 /* set local variables */
@@ -809,23 +1591,7 @@ void fs_etpu_set_chan_local_32_ext(
   uint32_t offset,
   uint32_t value)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  *(uint32_t *)((uint32_t)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset) = value;
+  fs_etpu_set_chan_local_32_mod(fs_etpu_module_ext(em), channel, offset, value);
 }
 
 /*******************************************************************************
@@ -849,23 +1615,7 @@ void fs_etpu_set_chan_local_24_ext(
   uint32_t offset,
   uint24_t value)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start_pse;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start_pse = fs_etpu_data_ram_ext;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start_pse = fs_etpu_c_data_ram_ext;
-	  break;
-  }
-
-  *(uint32_t *)((uint32_t)data_ram_start_pse + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset-1) = value;
+  fs_etpu_set_chan_local_24_mod(fs_etpu_module_ext(em), channel, offset, value);
 }
 
 /*******************************************************************************
@@ -884,23 +1634,7 @@ void fs_etpu_set_chan_local_16_ext(
   uint32_t offset,
   uint16_t value)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  *(uint16_t *)((uint32_t)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset) = value;
+  fs_etpu_set_chan_local_16_mod(fs_etpu_module_ext(em), channel, offset, value);
 }
 
 /*******************************************************************************
@@ -919,23 +1653,7 @@ void fs_etpu_set_chan_local_8_ext(
   uint32_t offset,
   uint8_t value)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  *(uint8_t *)((uint32_t)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset) = value;
+  fs_etpu_set_chan_local_8_mod(fs_etpu_module_ext(em), channel, offset, value);
 }
 
 /* get local variables */
@@ -955,23 +1673,7 @@ uint32_t fs_etpu_get_chan_local_32_ext(
   uint8_t channel,
   uint32_t offset)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return(*(uint32_t *)((uint32_t)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset));
+  return(fs_etpu_get_chan_local_32_mod(fs_etpu_module_ext(em), channel, offset));
 }
 
 /*******************************************************************************
@@ -992,23 +1694,7 @@ int24_t fs_etpu_get_chan_local_24s_ext(
   uint8_t channel,
   uint32_t offset)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start_pse;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start_pse = fs_etpu_data_ram_ext;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start_pse = fs_etpu_c_data_ram_ext;
-	  break;
-  }
-
-  return(*(int32_t *)((uint32_t)data_ram_start_pse + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset-1));
+  return(fs_etpu_get_chan_local_24s_mod(fs_etpu_module_ext(em), channel, offset));
 }
 
 /*******************************************************************************
@@ -1016,34 +1702,18 @@ int24_t fs_etpu_get_chan_local_24s_ext(
 ****************************************************************************//*!
 * @brief   This function reads a unsigned 24-bit parameter from an eTPU channel.
 *
-* @param   channel - The eTPU channel number
-* @param   offset - The byte offset to the parameter. This must be a 24-bit
-*          aligned value. This value is normally provided by the eTPU compiler.
-*
-* @return  The unsigned 24-bit value of the parameter.
-*******************************************************************************/
-uint24_t fs_etpu_get_chan_local_24_ext(
-  ETPU_MODULE em,
-  uint8_t channel,
-  uint32_t offset)
-{
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return(0x00FFFFFF & (*(uint32_t *)((uint32_t)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset-1)));
+* @param   channel - The eTPU channel number
+* @param   offset - The byte offset to the parameter. This must be a 24-bit
+*          aligned value. This value is normally provided by the eTPU compiler.
+*
+* @return  The unsigned 24-bit value of the parameter.
+*******************************************************************************/
+uint24_t fs_etpu_get_chan_local_24_ext(
+  ETPU_MODULE em,
+  uint8_t channel,
+  uint32_t offset)
+{
+  return(fs_etpu_get_chan_local_24_mod(fs_etpu_module_ext(em), channel, offset));
 }
 
 /*******************************************************************************
@@ -1062,23 +1732,7 @@ uint16_t fs_etpu_get_chan_local_16_ext(
   uint8_t channel,
   uint32_t offset)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return(*(uint16_t *)((uint32_t)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset));
+  return(fs_etpu_get_chan_local_16_mod(fs_etpu_module_ext(em), channel, offset));
 }
 
 /*******************************************************************************
@@ -1097,23 +1751,7 @@ uint8_t fs_etpu_get_chan_local_8_ext(
   uint8_t channel,
   uint32_t offset)
 {
-  volatile struct eTPU_struct * eTPU;
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return(*(uint8_t *)((uint32_t)data_ram_start + (eTPU->CHAN[channel].CR.B.CPBA<<3) + offset));
+  return(fs_etpu_get_chan_local_8_mod(fs_etpu_module_ext(em), channel, offset));
 }
 
 /* set global variables */
@@ -1131,20 +1769,7 @@ void fs_etpu_set_global_32_ext(
   uint32_t offset,
   uint32_t value)
 {
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  *(uint32_t *)((uint32_t)data_ram_start + offset) = value;
+  fs_etpu_set_global_32_mod(fs_etpu_module_ext(em), offset, value);
 }
 
 /*******************************************************************************
@@ -1161,7 +1786,7 @@ void fs_etpu_set_global_24_ext(
   uint32_t offset,
   uint24_t value)
 {
-  *(uint32_t *)((uint32_t)fs_etpu_data_ram_ext + offset-1) = value;
+  fs_etpu_set_global_24_mod(fs_etpu_module_ext(em), offset, value);
 }
 
 /*******************************************************************************
@@ -1178,20 +1803,7 @@ void fs_etpu_set_global_16_ext(
   uint32_t offset,
   uint16_t value)
 {
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  *(uint16_t *)((uint32_t)data_ram_start + offset) = value;
+  fs_etpu_set_global_16_mod(fs_etpu_module_ext(em), offset, value);
 }
 
 /*******************************************************************************
@@ -1208,20 +1820,7 @@ void fs_etpu_set_global_8_ext(
   uint32_t offset,
   uint8_t value)
 {
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  *(uint8_t *)((uint32_t)data_ram_start + offset) = value;
+  fs_etpu_set_global_8_mod(fs_etpu_module_ext(em), offset, value);
 }
 
 /* get global variables */
@@ -1239,20 +1838,7 @@ uint32_t fs_etpu_get_global_32_ext(
   ETPU_MODULE em,
   uint32_t offset)
 {
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return(*(uint32_t *)((uint32_t)data_ram_start + offset));
+  return(fs_etpu_get_global_32_mod(fs_etpu_module_ext(em), offset));
 }
 
 /*******************************************************************************
@@ -1271,20 +1857,7 @@ int24_t fs_etpu_get_global_24s_ext(
   ETPU_MODULE em,
   uint32_t offset)
 {
-  uint32_t data_ram_start_pse;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_start_pse = fs_etpu_data_ram_ext;
-	  break;
-  case EM_C:
-	  data_ram_start_pse = fs_etpu_c_data_ram_ext;
-	  break;
-  }
-
-  return(*(int32_t *)((uint32_t)data_ram_start_pse + offset-1));
+  return(fs_etpu_get_global_24s_mod(fs_etpu_module_ext(em), offset));
 }
 
 /*******************************************************************************
@@ -1301,20 +1874,7 @@ uint24_t fs_etpu_get_global_24_ext(
   ETPU_MODULE em,
   uint32_t offset)
 {
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return(0x00FFFFFF & (*(uint32_t *)((uint32_t)data_ram_start + offset-1)));
+  return(fs_etpu_get_global_24_mod(fs_etpu_module_ext(em), offset));
 }
 
 /*******************************************************************************
@@ -1331,20 +1891,7 @@ uint16_t fs_etpu_get_global_16_ext(
   ETPU_MODULE em,
   uint32_t offset)
 {
-  uint32_t data_ram_start;
-
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
-  }
-
-  return(*(uint16_t *)((uint32_t)data_ram_start + offset));
+  return(fs_etpu_get_global_16_mod(fs_etpu_module_ext(em), offset));
 }
 
 /*******************************************************************************
@@ -1361,20 +1908,34 @@ uint8_t fs_etpu_get_global_8_ext(
   ETPU_MODULE em,
   uint32_t offset)
 {
-  uint32_t data_ram_start;
+  return(fs_etpu_get_global_8_mod(fs_etpu_module_ext(em), offset));
+}
 
-  switch (em)
+/*******************************************************************************
+* FUNCTION: fs_etpu_checksum_ext
+****************************************************************************//*!
+* @brief   This function returns a 32-bit checksum of a block of words -
+*          rotate left and add, so swapped words change it too.
+*
+* @param   *p_data - The pointer to the data, 32-bit aligned
+* @param   size - The size of the data in bytes, rounded down to words
+*
+* @return  The checksum.
+*******************************************************************************/
+uint32_t fs_etpu_checksum_ext(
+  uint32_t *p_data,
+  uint32_t size)
+{
+  uint32_t sum = 0;
+
+  size = size >> 2;
+
+  while(size--)
   {
-  case EM_AB:
-  default:
-	  data_ram_start = fs_etpu_data_ram_start;
-	  break;
-  case EM_C:
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  break;
+    sum = ((sum << 1) | (sum >> 31)) + *p_data++;
   }
 
-  return(*(uint8_t *)((uint32_t)data_ram_start + offset));
+  return(sum);
 }
 
 /*******************************************************************************
@@ -2159,6 +2720,24 @@ uint32_t fs_etpu_coherent_read_24_ext(
   uint32_t offset2,
   int32_t *value1,
   int32_t *value2)
+{
+  return(fs_etpu_coherent_read_24_mod(fs_etpu_module_ext(em), channel, offset1, offset2, value1, value2));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_coherent_read_24_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_coherent_read_24_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t fs_etpu_coherent_read_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  int32_t *value1,
+  int32_t *value2)
 {
   uint32_t addr1, addr2, ctbase1, ctbase2;
   uint32_t addr_b;
@@ -2168,22 +2747,10 @@ uint32_t fs_etpu_coherent_read_24_ext(
   uint32_t data_ram_end;
   uint32_t *free_param;
 
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  data_ram_end = fs_etpu_data_ram_end;
-	  free_param = fs_etpu_free_param;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  data_ram_end = fs_etpu_c_data_ram_end;
-	  free_param = fs_etpu_c_free_param;
-	  break;
-  }
+  eTPU = p_mod->etpu;
+  data_ram_start = p_mod->data_ram_start;
+  data_ram_end = p_mod->data_ram_end;
+  free_param = *p_mod->free_param;
 
   /* check there is a DATA RAM space for the temporally buffer */
   if ((uint32_t)free_param + 8 > data_ram_end)
@@ -2253,6 +2820,24 @@ uint32_t fs_etpu_coherent_read_32_ext(
   uint32_t offset2,
   uint32_t *value1,
   uint32_t *value2)
+{
+  return(fs_etpu_coherent_read_32_mod(fs_etpu_module_ext(em), channel, offset1, offset2, value1, value2));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_coherent_read_32_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_coherent_read_32_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t fs_etpu_coherent_read_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  uint32_t *value1,
+  uint32_t *value2)
 {
   uint32_t addr1, addr2, ctbase1, ctbase2;
   uint32_t addr_b;
@@ -2262,22 +2847,10 @@ uint32_t fs_etpu_coherent_read_32_ext(
   uint32_t data_ram_end;
   uint32_t *free_param;
 
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  data_ram_end = fs_etpu_data_ram_end;
-	  free_param = fs_etpu_free_param;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  data_ram_end = fs_etpu_c_data_ram_end;
-	  free_param = fs_etpu_c_free_param;
-	  break;
-  }
+  eTPU = p_mod->etpu;
+  data_ram_start = p_mod->data_ram_start;
+  data_ram_end = p_mod->data_ram_end;
+  free_param = *p_mod->free_param;
 
 
   /* check there is a DATA RAM space for the temporally buffer */
@@ -2348,6 +2921,24 @@ uint32_t fs_etpu_coherent_write_24_ext(
   uint32_t offset2,
   int32_t value1,
   int32_t value2)
+{
+  return(fs_etpu_coherent_write_24_mod(fs_etpu_module_ext(em), channel, offset1, offset2, value1, value2));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_coherent_write_24_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_coherent_write_24_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t fs_etpu_coherent_write_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  int32_t value1,
+  int32_t value2)
 {
   uint32_t addr1, addr2, ctbase1, ctbase2;
   uint32_t addr_b;
@@ -2357,22 +2948,10 @@ uint32_t fs_etpu_coherent_write_24_ext(
   uint32_t data_ram_end;
   uint32_t *free_param;
 
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  data_ram_end = fs_etpu_data_ram_end;
-	  free_param = fs_etpu_free_param;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  data_ram_end = fs_etpu_c_data_ram_end;
-	  free_param = fs_etpu_c_free_param;
-	  break;
-  }
+  eTPU = p_mod->etpu;
+  data_ram_start = p_mod->data_ram_start;
+  data_ram_end = p_mod->data_ram_end;
+  free_param = *p_mod->free_param;
 
 
   /* check there is a DATA RAM space for the temporally buffer */
@@ -2444,6 +3023,24 @@ uint32_t fs_etpu_coherent_write_32_ext(
   uint32_t offset2,
   uint32_t value1,
   uint32_t value2)
+{
+  return(fs_etpu_coherent_write_32_mod(fs_etpu_module_ext(em), channel, offset1, offset2, value1, value2));
+}
+
+/*******************************************************************************
+* FUNCTION: fs_etpu_coherent_write_32_mod
+****************************************************************************//*!
+* @brief   Same as @ref fs_etpu_coherent_write_32_ext, on a module handle.
+*
+* @param   p_mod - The module handle from @ref fs_etpu_module_ext
+*******************************************************************************/
+uint32_t fs_etpu_coherent_write_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  uint32_t value1,
+  uint32_t value2)
 {
   uint32_t addr1, addr2, ctbase1, ctbase2;
   uint32_t addr_b;
@@ -2453,22 +3050,10 @@ uint32_t fs_etpu_coherent_write_32_ext(
   uint32_t data_ram_end;
   uint32_t *free_param;
 
-  switch (em)
-  {
-  case EM_AB:
-  default:
-	  eTPU = eTPU_AB;
-	  data_ram_start = fs_etpu_data_ram_start;
-	  data_ram_end = fs_etpu_data_ram_end;
-	  free_param = fs_etpu_free_param;
-	  break;
-  case EM_C:
-	  eTPU = eTPU_C;
-	  data_ram_start = fs_etpu_c_data_ram_start;
-	  data_ram_end = fs_etpu_c_data_ram_end;
-	  free_param = fs_etpu_c_free_param;
-	  break;
-  }
+  eTPU = p_mod->etpu;
+  data_ram_start = p_mod->data_ram_start;
+  data_ram_end = p_mod->data_ram_end;
+  free_param = *p_mod->free_param;
 
   /* check there is a DATA RAM space for the temporally buffer */
   if ((uint32_t)free_param + 8 > data_ram_end)
@@ -50,6 +50,48 @@ extern "C" {
 #define FALSE 0
 #endif
 
+/***************************************************************************//*!
+* @brief   Storage class of the module handle accessors below - override if
+*          the compiler spells inline differently
+*******************************************************************************/
+#ifndef FS_ETPU_INLINE
+#define FS_ETPU_INLINE static __inline
+#endif
+
+/***************************************************************************//*!
+* @brief   Number of free DATA RAM blocks tracked per module. Freed memory
+*          that does not fit is not released (see @ref fs_etpu_free_ext).
+*******************************************************************************/
+#ifndef FS_ETPU_SDM_FREE_BLOCK_CNT
+#define FS_ETPU_SDM_FREE_BLOCK_CNT  16
+#endif
+
+/***************************************************************************//*!
+* @brief   DATA RAM window addressed by one CDC transfer (CTBASE), in bytes
+*******************************************************************************/
+#define FS_ETPU_SDM_CDC_WINDOW      512
+
+/***************************************************************************//*!
+* @brief   fs_etpu_malloc_align flags
+*******************************************************************************/
+#define FS_ETPU_MALLOC_CDC          0x01 /* keep the block within one CDC window */
+
+/***************************************************************************//*!
+* @brief   Run-length compressed code image (see @ref fs_etpu_init_rle_ext).
+*          The image is 32-bit words: a header of FS_ETPU_CODE_RLE_MAGIC, the
+*          uncompressed size in bytes and its @ref fs_etpu_checksum_ext, then
+*          records.  A record is a control word of a word count, followed by
+*          that many literal words, or with FS_ETPU_CODE_RLE_RUN set, by one
+*          word repeated count times.
+*******************************************************************************/
+#define FS_ETPU_CODE_RLE_MAGIC      0x524C4531 /* "RLE1" */
+#define FS_ETPU_CODE_RLE_HEADER_CNT 3          /* header words */
+#define FS_ETPU_CODE_RLE_RUN        0x80000000 /* control word run flag */
+#define FS_ETPU_CODE_RLE_RUN_MIN    3          /* shorter runs stay literal */
+/* header fields of an image - the code as loaded into code memory */
+#define FS_ETPU_CODE_RLE_SIZE(rle_code)     ((rle_code)[1]) /* bytes */
+#define FS_ETPU_CODE_RLE_CHECKSUM(rle_code) ((rle_code)[2]) /* fs_etpu_checksum_ext */
+
 /*******************************************************************************
 * Global variables
 *******************************************************************************/
@@ -92,6 +134,48 @@ typedef int32_t fract24_t;
 typedef uint32_t uint24_t;
 typedef int32_t int24_t;
 
+/* A free DATA RAM block (host addresses, bytes) */
+struct etpu_sdm_block_t{
+  uint32_t start;
+  uint32_t size;
+};
+
+/* DATA RAM heap of one eTPU module - the top is free_param, freed blocks
+   below it are kept in an address-ordered list and reused best-fit */
+struct etpu_sdm_heap_t{
+  uint32_t base;             /* free_param when the heap was first used */
+  uint32_t free_bytes;       /* in the free list */
+  uint32_t peak_bytes;
+  uint16_t fail_cnt;
+  uint16_t free_cnt;
+  struct etpu_sdm_block_t free_list[FS_ETPU_SDM_FREE_BLOCK_CNT];
+};
+
+/* DATA RAM heap statistics */
+struct etpu_sdm_stats_t{
+  uint32_t total_bytes;      /* heap base to the end of DATA RAM */
+  uint32_t used_bytes;
+  uint32_t peak_bytes;
+  uint32_t free_bytes;       /* free list and above the top */
+  uint32_t top_bytes;        /* above the top */
+  uint32_t largest_free_bytes;
+  uint16_t free_block_cnt;   /* in the free list */
+  uint16_t fail_cnt;         /* allocations that failed */
+  uint8_t  fragmentation;    /* % of free bytes outside the largest free block */
+};
+
+/* Module handle - the engine registers and DATA RAM bounds of one eTPU module,
+   resolved once by fs_etpu_module_ext, so the _mod accessors need no engine
+   selection */
+struct etpu_module_t{
+  volatile struct eTPU_struct *etpu;
+  uint32_t data_ram_start;
+  uint32_t data_ram_end;
+  uint32_t data_ram_ext;     /* PSE mirror */
+  uint32_t **free_param;
+  struct etpu_sdm_heap_t *heap;
+};
+
 /* Configuration structure */
 struct etpu_config_t{
   uint32_t mcr;
@@ -124,6 +208,31 @@ uint32_t fs_etpu2_init_ext(
   struct etpu_config_t *p_etpu_config,
   uint32_t engine_mem_size);
 
+uint32_t fs_etpu_init_rle_ext(
+  ETPU_MODULE em,
+  struct etpu_config_t *p_etpu_config,
+  uint32_t *rle_code,
+  uint32_t rle_code_size,
+  uint32_t *globals,
+  uint32_t globals_size);
+
+uint32_t fs_etpu_warm_init_ext(
+  ETPU_MODULE em,
+  struct etpu_config_t *p_etpu_config,
+  uint32_t code_size,
+  uint32_t code_checksum,
+  uint32_t globals_size);
+
+uint32_t fs_etpu2_warm_init_ext(
+  ETPU_MODULE em,
+  uint32_t engine_mem_size);
+
+uint32_t fs_etpu_code_rle_compress_ext(
+  uint32_t *rle_code,
+  uint32_t rle_code_size,
+  uint32_t *code,
+  uint32_t code_size);
+
 /* eTPU Channel Initialization */
 uint32_t *fs_etpu_chan_init_ext(
   ETPU_MODULE em,
@@ -142,6 +251,21 @@ uint32_t *fs_etpu_malloc2_ext(
   ETPU_MODULE em,
   uint8_t channel,
   uint16_t num_bytes);
+uint32_t *fs_etpu_malloc_align_ext(
+  ETPU_MODULE em,
+  uint16_t num_bytes,
+  uint8_t flags);
+uint32_t fs_etpu_free_ext(
+  ETPU_MODULE em,
+  uint32_t *p_mem,
+  uint16_t num_bytes);
+uint32_t fs_etpu_claim_ext(
+  ETPU_MODULE em,
+  uint32_t *p_mem,
+  uint16_t num_bytes);
+void fs_etpu_get_sdm_stats_ext(
+  ETPU_MODULE em,
+  struct etpu_sdm_stats_t *p_stats);
 
 /* Run-Time eTPU Module Control */
 void fs_timer_start_ext(
@@ -355,7 +479,61 @@ void fs_etpu_clear_idle_cnt_a_ext(
 void fs_etpu_clear_idle_cnt_b_ext(
   ETPU_MODULE em);
 
+/* Module handle */
+const struct etpu_module_t *fs_etpu_module_ext(
+  ETPU_MODULE em);
+uint32_t *fs_etpu_malloc_mod(
+  const struct etpu_module_t *p_mod,
+  uint16_t num_bytes);
+uint32_t *fs_etpu_malloc2_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint16_t num_bytes);
+uint32_t *fs_etpu_malloc_align_mod(
+  const struct etpu_module_t *p_mod,
+  uint16_t num_bytes,
+  uint8_t flags);
+uint32_t fs_etpu_free_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t *p_mem,
+  uint16_t num_bytes);
+uint32_t fs_etpu_claim_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t *p_mem,
+  uint16_t num_bytes);
+uint32_t fs_etpu_coherent_read_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  int32_t *value1,
+  int32_t *value2);
+uint32_t fs_etpu_coherent_read_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  uint32_t *value1,
+  uint32_t *value2);
+uint32_t fs_etpu_coherent_write_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  int32_t value1,
+  int32_t value2);
+uint32_t fs_etpu_coherent_write_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset1,
+  uint32_t offset2,
+  uint32_t value1,
+  uint32_t value2);
+
 /* Others */
+uint32_t fs_etpu_checksum_ext(
+  uint32_t *p_data,
+  uint32_t size);
 uint32_t *fs_memcpy32_ext(
   uint32_t *dest,
   uint32_t *source,
@@ -366,6 +544,188 @@ void fs_memset32_ext(
   int32_t size);
 
 
+/*******************************************************************************
+* Module handle accessors
+*   Take a handle from fs_etpu_module_ext, otherwise as the _ext functions of
+*   the same name.  The _ext functions are wrappers of these.
+*******************************************************************************/
+/* channel base address (CPBA) in bytes from the DATA RAM start */
+#define FS_ETPU_MOD_CPBA(p_mod, channel) \
+  ((uint32_t)(p_mod)->etpu->CHAN[channel].CR.B.CPBA << 3)
+
+FS_ETPU_INLINE uint32_t *fs_etpu_get_cpba_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel)
+{
+  return((uint32_t*)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel)));
+}
+
+FS_ETPU_INLINE uint32_t *fs_etpu_get_cpba_pse_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel)
+{
+  return((uint32_t*)(p_mod->data_ram_ext + FS_ETPU_MOD_CPBA(p_mod, channel)));
+}
+
+FS_ETPU_INLINE void fs_etpu_set_hsr_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint8_t hsr)
+{
+  p_mod->etpu->CHAN[channel].HSRR.R = hsr;
+}
+
+FS_ETPU_INLINE uint8_t fs_etpu_get_hsr_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel)
+{
+  return((uint8_t)p_mod->etpu->CHAN[channel].HSRR.R);
+}
+
+FS_ETPU_INLINE void fs_etpu_set_chan_local_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset,
+  uint32_t value)
+{
+  *(uint32_t *)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel) + offset) = value;
+}
+
+FS_ETPU_INLINE void fs_etpu_set_chan_local_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset,
+  uint24_t value)
+{
+  *(uint32_t *)(p_mod->data_ram_ext + FS_ETPU_MOD_CPBA(p_mod, channel) + offset-1) = value;
+}
+
+FS_ETPU_INLINE void fs_etpu_set_chan_local_16_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset,
+  uint16_t value)
+{
+  *(uint16_t *)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel) + offset) = value;
+}
+
+FS_ETPU_INLINE void fs_etpu_set_chan_local_8_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset,
+  uint8_t value)
+{
+  *(uint8_t *)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel) + offset) = value;
+}
+
+FS_ETPU_INLINE uint32_t fs_etpu_get_chan_local_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset)
+{
+  return(*(uint32_t *)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel) + offset));
+}
+
+FS_ETPU_INLINE int24_t fs_etpu_get_chan_local_24s_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset)
+{
+  return(*(int32_t *)(p_mod->data_ram_ext + FS_ETPU_MOD_CPBA(p_mod, channel) + offset-1));
+}
+
+FS_ETPU_INLINE uint24_t fs_etpu_get_chan_local_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset)
+{
+  return(0x00FFFFFF & (*(uint32_t *)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel) + offset-1)));
+}
+
+FS_ETPU_INLINE uint16_t fs_etpu_get_chan_local_16_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset)
+{
+  return(*(uint16_t *)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel) + offset));
+}
+
+FS_ETPU_INLINE uint8_t fs_etpu_get_chan_local_8_mod(
+  const struct etpu_module_t *p_mod,
+  uint8_t channel,
+  uint32_t offset)
+{
+  return(*(uint8_t *)(p_mod->data_ram_start + FS_ETPU_MOD_CPBA(p_mod, channel) + offset));
+}
+
+FS_ETPU_INLINE void fs_etpu_set_global_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset,
+  uint32_t value)
+{
+  *(uint32_t *)(p_mod->data_ram_start + offset) = value;
+}
+
+FS_ETPU_INLINE void fs_etpu_set_global_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset,
+  uint24_t value)
+{
+  *(uint32_t *)(p_mod->data_ram_ext + offset-1) = value;
+}
+
+FS_ETPU_INLINE void fs_etpu_set_global_16_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset,
+  uint16_t value)
+{
+  *(uint16_t *)(p_mod->data_ram_start + offset) = value;
+}
+
+FS_ETPU_INLINE void fs_etpu_set_global_8_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset,
+  uint8_t value)
+{
+  *(uint8_t *)(p_mod->data_ram_start + offset) = value;
+}
+
+FS_ETPU_INLINE uint32_t fs_etpu_get_global_32_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset)
+{
+  return(*(uint32_t *)(p_mod->data_ram_start + offset));
+}
+
+FS_ETPU_INLINE int24_t fs_etpu_get_global_24s_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset)
+{
+  return(*(int32_t *)(p_mod->data_ram_ext + offset-1));
+}
+
+FS_ETPU_INLINE uint24_t fs_etpu_get_global_24_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset)
+{
+  return(0x00FFFFFF & (*(uint32_t *)(p_mod->data_ram_start + offset-1)));
+}
+
+FS_ETPU_INLINE uint16_t fs_etpu_get_global_16_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset)
+{
+  return(*(uint16_t *)(p_mod->data_ram_start + offset));
+}
+
+FS_ETPU_INLINE uint8_t fs_etpu_get_global_8_mod(
+  const struct etpu_module_t *p_mod,
+  uint32_t offset)
+{
+  return(*(uint8_t *)(p_mod->data_ram_start + offset));
+}
+
+
 /*******************************************************************************
 * Definition of Terms
 *******************************************************************************/
@@ -440,6 +800,8 @@ void fs_memset32_ext(
 #define FS_ETPU_PRIORITY_PASSING_ENABLE   0x00000000 /* Scheduler Priority Passing */
 #define FS_ETPU_PRIORITY_PASSING_DISABLE  0x00000080 /* eTPU2 only */
 
+#define FS_ETPU_ENTRY_TABLE_BASE_MASK  0x0000001F /* Entry Table Base */
+
 /* TBCR - Time Base Configuration Register */
 #define FS_ETPU_TCRCLK_MODE_2SAMPLE     0x00000000 /* TCRCLK Signal Filter Control*/
 #define FS_ETPU_TCRCLK_MODE_INTEGRATION 0x10000000
@@ -519,6 +881,7 @@ void fs_memset32_ext(
 #define FS_ETPU_ERROR_ADDRESS          6
 #define FS_ETPU_ERROR_TIMING           7
 #define FS_ETPU_ERROR_UNINITIALIZED    8
+#define FS_ETPU_ERROR_CHECKSUM         9
 
 #ifdef __cplusplus
 }
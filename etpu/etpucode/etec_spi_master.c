@@ -13,6 +13,7 @@
 #define  SPI_MASTER_INIT_TCR1_HSR      7
 #define  SPI_MASTER_INIT_TCR2_HSR      5
 #define  SPI_MASTER_RUN_HSR            3
+#define  SPI_MASTER_COUNTERS_HSR       6
 /* Function Modes */
 #define  SPI_MASTER_CPHA_0_FM0         0
 #define  SPI_MASTER_CPHA_1_FM0         1
@@ -20,11 +21,44 @@
 #define  SPI_MASTER_SHIFT_DIR_LSB_FM1  1
 /* other definitions */
 #define  SPI_MASTER_MAX_SLAVE_SELECT_CNT 4
+/* match B (trailing) states */
+#define  SPI_MASTER_TRAILING_CLOCK     0
+#define  SPI_MASTER_TRAILING_ANGLE     1
+#define  SPI_MASTER_TRAILING_REFRESH   2
+/* end of word states of the MISO sample delay tables - not match B events */
+#define  SPI_MASTER_TRAILING_SAMPLE    3     /* last edge done, last sample due */
+#define  SPI_MASTER_TRAILING_SAMPLED   4     /* last sample done, last edge due */
+/* CRC phases */
+#define  SPI_MASTER_CRC_PHASE_DATA     0
+#define  SPI_MASTER_CRC_PHASE_CRC      1
+/* multi word transfers (_xfer_mode) */
+#define  SPI_MASTER_XFER_WORD          0
+#define  SPI_MASTER_XFER_BURST         1
+#define  SPI_MASTER_XFER_CHAIN         2
+#define  SPI_MASTER_XFER_STREAM        3
+
+#define  SPI_MASTER_SS_CHAN_BITS       6     /* per channel in _slave_select_chan_pack */
+#define  SPI_MASTER_SS_CHAN_MASK       0x3f  /* also the unused entry */
+
+/* counters saturate rather than wrap, and are kept only if allocated */
+#define  SPI_MASTER_COUNT(cnt)         if (_counters != 0) { if (_counters->cnt != 0xffffff) { _counters->cnt++; } }
 
 /***********************************/
 /* Verify performance requirements */
 /***********************************/
-#pragma verify_wctl  SPI_master                 35  steps  10 rams
+/* the word start and end paths (burst, chain, stream, angle) */
+#pragma verify_wctl  SPI_master                 110 steps  45 rams
+/* the per bit threads, which set the maximum baud rate */
+#pragma verify_wctl  SPI_master::ClockLeading_CPHA0_LSB   16 steps  6 rams
+#pragma verify_wctl  SPI_master::ClockLeading_CPHA0_MSB   16 steps  6 rams
+#pragma verify_wctl  SPI_master::ClockLeading_CPHA0_DLY   16 steps  6 rams
+#pragma verify_wctl  SPI_master::ClockLeading_CPHA1_LSB   16 steps  6 rams
+#pragma verify_wctl  SPI_master::ClockLeading_CPHA1_MSB   16 steps  6 rams
+#pragma verify_wctl  SPI_master::SampleLSB                16 steps  5 rams
+#pragma verify_wctl  SPI_master::SampleMSB                16 steps  5 rams
+#pragma verify_wctl  SPI_master::ClockLeading_CPHA0_CRC   28 steps 12 rams
+#pragma verify_wctl  SPI_master::ClockLeading_CPHA1_CRC   28 steps 12 rams
+#pragma verify_wctl  SPI_master::SampleCRC                28 steps 12 rams
 #pragma exclude_wctl SPI_master::InitTCR1
 #pragma exclude_wctl SPI_master::InitTCR2
 
@@ -36,6 +70,133 @@
    SCLK     - channel
    MOSI     - channel + 1
    SS       - slave_select_chan [optional]
+   SS ADDR  - _ss_addr_chan .. _ss_addr_chan + _ss_addr_bit_count - 1 [optional]
+*/
+
+/*
+   slave select : the slave select (and latch, and decoder address) edges are
+   output pin actions on matches of their own channels, so they land at exact
+   TCR times and need no service.  SS is asserted by its match A at the run
+   time and released by its match B half a bit after the last clock edge.
+   The end of transfer interrupt is raised on the last clock edge; if the
+   next run comes before the release has occurred it is started half a bit
+   after the release.
+*/
+
+/*
+   decoder addressed slave select : when _ss_addr_bit_count is non-zero (3 or
+   5), the slave select channel is the enable of an external decoder and
+   _slave_select_addr is driven, LSB on _ss_addr_chan, onto consecutive
+   channels half a bit before the enable is asserted.  The address is stable for
+   the whole transfer, so the usual _slave_select_delay timing applies.
+*/
+
+/*
+   angle mode : when _angle_table_cnt is non-zero, transfers are started from
+   a match B on TCR2 (angle) at each _angle_table entry in turn, rather than
+   from the run HSR.  The clock is still timed on TCR1.  Each entry provides
+   the slave select channel and data out, and receives the data in.
+*/
+
+/*
+   optional state : the frame holds only what every transfer needs.  The
+   state of the CRC, multi word transfers and counters is in DATA RAM blocks
+   the host allocates only when the feature is configured, reached through
+   _crc, _burst, _chain, _stream and _counters - a null pointer disables the
+   feature.
+*/
+
+/*
+   CRC : when _crc is non-zero (MSB first only), a CRC is computed
+   bit-serially over the data out and the data in.  crc->bit_count CRC bits
+   (crc->out ^ crc->xorout) are appended to the transmitted word, and the CRC
+   run over the received word and its CRC must equal crc->residue.  Registers
+   are left-justified in 24 bits.  A mismatch sets crc->error before the
+   normal interrupt that ends the word, burst, chain or half ring, so the
+   host finds it there.  The eTPU only ever sets crc->error, the host clears
+   it when it reads it.
+*/
+
+/*
+   multi word transfers : the run HSR transfers a single word, or the burst,
+   daisy chain or stream block selected by _xfer_mode, each headed by a
+   SPI_master_xfer_t.  The host sets _xfer_mode before issuing the run HSR.
+*/
+
+/*
+   burst read : the run HSR sends a cmd_bit_count bit command (_data_out_reg)
+   followed by xfer.cnt words of _bit_count bits, each transmitting dummy, all
+   under one slave select assertion.  The response words are written to
+   rx_buf and one interrupt is raised at the end of the transaction.
+*/
+
+/*
+   daisy chain : the run HSR shifts the data_out of every entry, back to
+   back under one slave select assertion, storing each data_in alongside.
+   An optional pulse of latch_width is then driven on latch_chan
+   (latch_polarity is the idle level).  If xfer.run is set, the whole chain
+   is sent again every refresh_period from the start of the previous
+   transfer, without host involvement, until the host clears xfer.run.
+*/
+
+/*
+   MISO sample delay : when _miso_sample_delay is non-zero (and less than
+   _half_period), the host selects a SPI_master_x_DLY entry table, whose
+   sampling edge thread does not read MISO.  Instead matches A and B on the
+   MISO channel are both set to the sampling edge time plus
+   _miso_sample_delay; the pair dispatches to the Sample threads.  The last
+   bit's Sample thread and last clock edge can run in either order, so the
+   word is finished by whichever comes second: the SCLK thread goes on with
+   FinishWord if _trailing_state is SAMPLED, else leaves it at SAMPLE; the
+   Sample thread sets SAMPLED, or if it finds SAMPLE links to the SCLK
+   channel, whose SampleLink thread finishes the word.
+   The eTPU has no pin latch on a match - the Sample threads read PSS, the
+   pin state when the thread starts, so MISO is really sampled at the match
+   plus the service latency (the other channels' threads ahead in the
+   scheduler, plus the thread's own first step).  The delay must leave room
+   for that: _miso_sample_delay + worst case latency must be under the time
+   MISO stays valid, about _half_period after the edge plus the slave's
+   output delay.
+*/
+
+/*
+   per bit threads : the clock edge threads make no feature tests.  Each
+   clock phase and shift direction has its own entry table, and the CRC
+   (MSB first only) and MISO sample delay each select a further variant, so
+   the tests are made once, by the host, in the choice of table.  A match B
+   that is not a clock edge - the chain refresh or angle start - is flagged
+   by FLAG1 and dispatches to TrailingEvent, which looks at _trailing_state.
+*/
+
+/*
+   streaming : the run HSR clocks the words of the buf ring back to back,
+   without a gap, until the host clears xfer.run.  Each word's data in
+   replaces its data out in the ring, and an interrupt is raised each time
+   half the ring is done, for the host to read and refill that half.  The
+   slave select output is a frame sync, active for the first word of each
+   frame_cnt word frame (I2S word select with a frame of 2), its edges placed
+   at the word boundaries.  Stopping takes effect at the end of a frame,
+   which raises the interrupt also when it is not the end of a half ring.
+*/
+
+/*
+   counters : when _counters is non-zero, rx_overrun_cnt counts transfers
+   (stream half rings) in before the host read the last one (_rx_full),
+   tx_underrun_cnt stream half rings sent again because the host had not
+   refilled the ring (_tx_fresh) and error_cnt unexpected entries.  The
+   counters HSR copies them to the snap_ set and clears them in one thread,
+   giving the host a coherent snapshot.  Counters are 24-bit and saturate at
+   0xffffff; the host clears the block at init.
+*/
+
+/*
+   DDR : for eTPU to eTPU links, the SPI_master_DDR_x entry tables transfer
+   a bit on both clock edges.  Each edge thread reads MISO, then drives the
+   next MOSI bit a quarter bit after the edge on a MOSI match A, so MOSI is
+   stable while the slave samples it.  The slave likewise drives MISO a hold
+   time after each edge.  The first bit is put out by the run (as CPHA 0),
+   _bit_count must be even so the clock ends at its idle level, and CRC,
+   burst, daisy chain and MISO sample delay are not used.
 */
 
 #if 0
@@ -50,6 +211,78 @@ typedef unsigned int24  uint24_t;
 typedef unsigned int32  uint32_t;
 #endif
 
+typedef struct
+{
+    uint24_t    angle;
+    uint24_t    slave_select_chan;
+    uint24_t    slave_select_addr;
+    uint24_t    data_out;
+    uint24_t    data_in;
+} SPI_master_angle_entry_t;
+
+typedef struct
+{
+    uint24_t    data_out;
+    uint24_t    data_in;
+} SPI_master_chain_entry_t;
+
+typedef struct
+{
+    uint24_t    poly;
+    uint24_t    init;
+    uint24_t    xorout;
+    uint24_t    residue;
+    int24_t     bit_count;
+    int24_t     error;
+    uint24_t    out;
+    uint24_t    in;
+    int24_t     phase;
+} SPI_master_crc_t;
+
+typedef struct
+{
+    int24_t     cnt;                /* words */
+    int24_t     index;              /* word being transferred */
+    int24_t     run;                /* chain refresh / streaming, cleared by the host */
+} SPI_master_xfer_t;
+
+typedef struct
+{
+    SPI_master_xfer_t xfer;
+    uint24_t    dummy;
+    int24_t     cmd_bit_count;
+    uint24_t    rx_buf[1];          /* sized by the host */
+} SPI_master_burst_t;
+
+typedef struct
+{
+    SPI_master_xfer_t xfer;
+    int24_t     refresh_period;
+    int24_t     latch_width;
+    int24_t     start_time;
+    uint24_t    latch_chan;         /* 0xff -> no latch pulse */
+    uint24_t    latch_polarity;     /* latch idle level */
+    SPI_master_chain_entry_t entry[1]; /* sized by the host */
+} SPI_master_chain_t;
+
+typedef struct
+{
+    SPI_master_xfer_t xfer;
+    int24_t     frame_cnt;
+    int24_t     frame_index;
+    uint24_t    buf[1];             /* sized by the host */
+} SPI_master_stream_t;
+
+typedef struct
+{
+    uint24_t    rx_overrun_cnt;
+    uint24_t    tx_underrun_cnt;
+    uint24_t    error_cnt;
+    uint24_t    snap_rx_overrun_cnt;
+    uint24_t    snap_tx_underrun_cnt;
+    uint24_t    snap_error_cnt;
+} SPI_master_counters_t;
+
 _eTPU_class SPI_master
 {
     /* channel frame */
@@ -62,15 +295,38 @@ public:
     uint24_t    _data_out_reg;
     uint24_t    _data_in_reg;
 
-    uint8_t     _slave_select_chan_list[SPI_MASTER_MAX_SLAVE_SELECT_CNT];
+    uint24_t    _slave_select_chan_pack; /* SS outputs, SPI_MASTER_SS_CHAN_BITS each */
     uint8_t     _slave_select_chan;
     int24_t     _slave_select_delay;
+    uint8_t     _slave_select_addr;
+    uint8_t     _ss_addr_chan;
+    int8_t      _ss_addr_bit_count; /* 0 -> no decoder */
+
+    SPI_master_angle_entry_t *_angle_table;
+    int8_t      _angle_table_cnt;   /* 0 -> angle mode disabled */
+
+    SPI_master_crc_t *_crc;         /* 0 -> CRC disabled */
+    SPI_master_burst_t *_burst;     /* 0 -> no burst read */
+    SPI_master_chain_t *_chain;     /* 0 -> no daisy chain */
+    SPI_master_stream_t *_stream;   /* 0 -> no streaming */
+    int8_t      _xfer_mode;         /* SPI_MASTER_XFER_x of the next run */
+    SPI_master_counters_t *_counters; /* 0 -> not counted */
+
+    int24_t     _miso_sample_delay; /* 0 -> sample MISO on the clock edge */
+
+    int8_t      _rx_full;           /* cleared by the host when it reads */
+    int8_t      _tx_fresh;          /* set by the host when it refills the ring */
+    uint24_t    _attach_sum;        /* host only - instance checksum for a warm restart */
 
 private:
     int8_t      _bit_count_current;
     uint24_t    _data_out_shift_reg;
     uint24_t    _data_in_shift_reg;
-    uint8_t     _slave_select_end;
+    uint8_t     _trailing_state;
+    int8_t      _angle_table_index;
+    int24_t     _ss_release_time;
+    uint8_t     _ss_release_chan;   /* 0xff -> no release pending */
+    _Bool       _use_TCR2;
 
     /* threads */
     
@@ -82,28 +338,354 @@ private:
     _eTPU_thread RunTCR1(_eTPU_matches_disabled);
     _eTPU_thread RunTCR2(_eTPU_matches_disabled);
 
+    /* counters */
+    _eTPU_thread CountersSnapshot(_eTPU_matches_enabled);
+    _eTPU_thread ErrorHandler(_eTPU_matches_enabled);
+
+    /* MISO delayed sample threads */
+    _eTPU_thread SampleLSB(_eTPU_matches_enabled);
+    _eTPU_thread SampleMSB(_eTPU_matches_enabled);
+    _eTPU_thread SampleCRC(_eTPU_matches_enabled);
+    _eTPU_thread SampleLink(_eTPU_matches_enabled);
+
+    /* match B which is not a clock edge */
+    _eTPU_thread TrailingEvent(_eTPU_matches_enabled);
+
     /* SCLK working threads */
-    _eTPU_thread ClockLeadingLSB(_eTPU_matches_enabled);
-    _eTPU_thread ClockLeadingMSB(_eTPU_matches_enabled);
-    _eTPU_thread ClockTrailingLSB(_eTPU_matches_enabled);
-    _eTPU_thread ClockTrailingMSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA0_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA0_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA1_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA1_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA0_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA0_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA1_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA1_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA0_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA1_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA0_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA1_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA0_DLY(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA1_DLY(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_DDR_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_DDR_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_DDR_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_DDR_MSB(_eTPU_matches_enabled);
 
     /* fragments */
     _eTPU_fragment CommonInit();
     _eTPU_fragment CommonRun();
     _eTPU_fragment SetTrailingEdge();
+    _eTPU_fragment ScheduleSample_CPHA0();
+    _eTPU_fragment ScheduleSample_CPHA1();
     _eTPU_fragment WriteData_CPHA0();
+    _eTPU_fragment WriteData_CPHA0_CRC();
     _eTPU_fragment ReadData_CPHA1();
+    _eTPU_fragment LastEdge();
+    _eTPU_fragment WriteData_DDR();
     _eTPU_fragment FinishWord();
+    _eTPU_fragment TrailingStateChange();
+    _eTPU_fragment AngleRun();
+    _eTPU_fragment NextAngle();
+    _eTPU_fragment ScheduleAngle();
+    _eTPU_fragment StartCRC();
+    _eTPU_fragment NextWord();
+    _eTPU_fragment ChainDone();
     
     /* methods */
-    /* none */
+    void InitMatchOutput();
+    void StreamStore();
+    void LastSample();
+    void CRCOut();
+    void CRCIn();
+
+    /* entry table(s) - one per clock phase and shift direction, with CRC
+       and MISO sample delay variants */
+    _eTPU_entry_table SPI_master_CPHA0_MSB;
+    _eTPU_entry_table SPI_master_CPHA0_LSB;
+    _eTPU_entry_table SPI_master_CPHA1_MSB;
+    _eTPU_entry_table SPI_master_CPHA1_LSB;
+    _eTPU_entry_table SPI_master_CPHA0_MSB_DLY;
+    _eTPU_entry_table SPI_master_CPHA0_LSB_DLY;
+    _eTPU_entry_table SPI_master_CPHA1_MSB_DLY;
+    _eTPU_entry_table SPI_master_CPHA1_LSB_DLY;
+    _eTPU_entry_table SPI_master_CPHA0_CRC;
+    _eTPU_entry_table SPI_master_CPHA1_CRC;
+    _eTPU_entry_table SPI_master_CPHA0_CRC_DLY;
+    _eTPU_entry_table SPI_master_CPHA1_CRC_DLY;
+    _eTPU_entry_table SPI_master_DDR_MSB;
+    _eTPU_entry_table SPI_master_DDR_LSB;
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA0_MSB, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleMSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleMSB),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA0_LSB, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleLSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleLSB),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA1_MSB, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleMSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleMSB),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA1_LSB, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleLSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleLSB),
+};
+
+/* MISO sample delay - the sampling edge schedules the MISO matches, the
+   last Sample thread may link back to the SCLK channel */
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA0_MSB_DLY, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA0_DLY),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA0_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleMSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleMSB),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA0_LSB_DLY, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA0_DLY),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA0_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleLSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleLSB),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA1_MSB_DLY, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA1_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA1_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleMSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleMSB),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA1_LSB_DLY, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA1_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA1_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleLSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleLSB),
+};
+
+/* CRC - MSB first only */
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA0_CRC, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleCRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleCRC),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA1_CRC, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleCRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleCRC),
+};
+
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA0_CRC_DLY, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA0_DLY),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA0_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleCRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleCRC),
+};
 
-    /* entry table(s) */
-    _eTPU_entry_table SPI_master;
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_CPHA1_CRC_DLY, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, SampleLink),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_CPHA1_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_CPHA1_DLY),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, SampleCRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, SampleCRC),
 };
 
-DEFINE_ENTRY_TABLE(SPI_master, SPI_master, alternate, outputpin, autocfsr)
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_DDR_MSB, alternate, outputpin, autocfsr)
 {
 	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
 	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
@@ -111,35 +693,43 @@ DEFINE_ENTRY_TABLE(SPI_master, SPI_master, alternate, outputpin, autocfsr)
 	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
 	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
 	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
-	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitTCR1),
-	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockLeadingLSB),
-	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, ClockLeadingLSB),
-	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockLeadingMSB),
-	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ClockLeadingMSB),
-	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockLeadingLSB),
-	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, ClockLeadingLSB),
-	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockLeadingMSB),
-	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ClockLeadingMSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockTrailingLSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, ClockTrailingLSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailingMSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ClockTrailingMSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockTrailingLSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, ClockTrailingLSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailingMSB),
-	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ClockTrailingMSB),
-	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_DDR_MSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_DDR_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_DDR_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_DDR_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	/* leading edge first, the trailing edge is then still pending */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, ClockLeading_DDR_MSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, ClockLeading_DDR_MSB),
 };
 
+DEFINE_ENTRY_TABLE(SPI_master, SPI_master_DDR_LSB, alternate, outputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, RunTCR2),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, RunTCR1),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, RunTCR2),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, InitTCR2),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, InitTCR1),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  x, x, ClockLeading_DDR_LSB),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  x, x, ClockLeading_DDR_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 0, ClockTrailing_DDR_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 0, ClockTrailing_DDR_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  x, 1, TrailingEvent),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  x, 1, TrailingEvent),
+	/* leading edge first, the trailing edge is then still pending */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  x, x, ClockLeading_DDR_LSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  x, x, ClockLeading_DDR_LSB),
+};
 
 _eTPU_thread SPI_master::InitTCR1(_eTPU_matches_disabled)
 {
@@ -147,6 +737,14 @@ _eTPU_thread SPI_master::InitTCR1(_eTPU_matches_disabled)
     channel.TBSA = TBS_M1C1GE;
     channel.TBSB = TBS_M1C1GE;
     channel.FLAG0 = 0;
+    _use_TCR2 = 0;
+    chan -= 1;
+    channel.TBSA = TBS_M1C1GE;
+    channel.TBSB = TBS_M1C1GE;
+    chan += 2;
+    channel.TBSA = TBS_M1C1GE;
+    channel.TBSB = TBS_M1C1GE;
+    chan -= 1;
     
     CommonInit();
 }
@@ -154,15 +752,13 @@ _eTPU_thread SPI_master::InitTCR1(_eTPU_matches_disabled)
 _eTPU_fragment SPI_master::CommonInit()
 {
     uint24_t i;
+    uint24_t ss_chan_pack;
+    uint8_t sclk_chan = chan;
 
     channel.PDCM = PDCM_EM_NB_ST;
-
-    /* SET FUNCTION MODE SHIFT DIRECTION AS FLAG 1 */
-    channel.FLAG1 = 1;      /* SHIFT MSB FIRST : default*/
-    if (channel.FM1 == SPI_MASTER_SHIFT_DIR_LSB_FM1)
-    {
-        channel.FLAG1 = 0;      /* SHIFT LSB FIRST */
-    }
+    _trailing_state = SPI_MASTER_TRAILING_CLOCK;
+    channel.FLAG1 = 0;
+    _ss_release_chan = 0xff;
 
     /* clear all latches */
     channel.LSR = LSR_CLEAR;
@@ -193,17 +789,120 @@ _eTPU_fragment SPI_master::CommonInit()
     /* turn off outout buffer on MISO chan */
     chan -= 1;
     channel.TBSA = TBSA_CLR_OBE;
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    if (_miso_sample_delay != 0)
+    {
+        /* MISO sampled on its own matches */
+        channel.PDCM = PDCM_EM_NB_ST;
+        channel.MTD = MTD_ENABLE;
+    }
+    /* MOSI is driven on its match A in DDR mode */
+    chan += 2;
+    channel.PDCM = PDCM_EM_NB_ST;
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
     
     /* initialize any slave select outputs */
+    ss_chan_pack = _slave_select_chan_pack;
     for (i = 0; i < SPI_MASTER_MAX_SLAVE_SELECT_CNT; i++)
     {
-        if (_slave_select_chan_list[i] != 0xff)
+        if ((ss_chan_pack & SPI_MASTER_SS_CHAN_MASK) != SPI_MASTER_SS_CHAN_MASK)
         {
-            chan = _slave_select_chan_list[i];
-            channel.TBSA = TBSA_SET_OBE;
+            chan = ss_chan_pack & SPI_MASTER_SS_CHAN_MASK;
+            InitMatchOutput();
+            /* asserted by match A, released by match B */
             channel.PIN = PIN_SET_HIGH;
+            channel.OPACA = OPAC_MATCH_LOW;
+            channel.OPACB = OPAC_MATCH_HIGH;
         }
+        ss_chan_pack >>= SPI_MASTER_SS_CHAN_BITS;
     }
+    /* latch output idles at its polarity level, pulsed by matches A and B */
+    if (_chain != 0)
+    {
+        SPI_master_chain_t *chain = _chain;
+
+        if (chain->latch_chan != 0xff)
+        {
+            chan = chain->latch_chan;
+            InitMatchOutput();
+            if (chain->latch_polarity == 0)
+            {
+                channel.PIN = PIN_SET_LOW;
+                channel.OPACA = OPAC_MATCH_HIGH;
+                channel.OPACB = OPAC_MATCH_LOW;
+            }
+            else
+            {
+                channel.PIN = PIN_SET_HIGH;
+                channel.OPACA = OPAC_MATCH_LOW;
+                channel.OPACB = OPAC_MATCH_HIGH;
+            }
+        }
+    }
+    /* and any decoder address outputs - the level is set per run on OPACA */
+    chan = _ss_addr_chan;
+    for (i = 0; i < _ss_addr_bit_count; i++)
+    {
+        InitMatchOutput();
+        channel.PIN = PIN_SET_LOW;
+        chan += 1;
+    }
+
+    /* angle mode - wait for the first angle target */
+    if (_angle_table_cnt != 0)
+    {
+        chan = sclk_chan;
+        _angle_table_index = 0;
+        ScheduleAngle();
+    }
+}
+
+void SPI_master::InitMatchOutput()
+{
+    /* an output driven only by match pin actions - the channel is never
+       serviced, both matches are on the function timebase */
+    channel.TBSA = TBSA_SET_OBE;
+    channel.PDCM = PDCM_EM_NB_ST;
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    if (_use_TCR2 != 0)
+    {
+        channel.TBSA = TBS_M2C2GE;
+        channel.TBSB = TBS_M2C2GE;
+    }
+    else
+    {
+        channel.TBSA = TBS_M1C1GE;
+        channel.TBSB = TBS_M1C1GE;
+    }
+}
+
+_eTPU_thread SPI_master::CountersSnapshot(_eTPU_matches_enabled)
+{
+    SPI_master_counters_t *counters = _counters;
+
+    /* copy and clear in one thread, so no count is lost or torn */
+    if (counters != 0)
+    {
+        counters->snap_rx_overrun_cnt = counters->rx_overrun_cnt;
+        counters->snap_tx_underrun_cnt = counters->tx_underrun_cnt;
+        counters->snap_error_cnt = counters->error_cnt;
+        counters->rx_overrun_cnt = 0;
+        counters->tx_underrun_cnt = 0;
+        counters->error_cnt = 0;
+    }
+}
+
+_eTPU_thread SPI_master::ErrorHandler(_eTPU_matches_enabled)
+{
+    /* unexpected entry - count it, then clear the latches that caused it */
+    SPI_MASTER_COUNT(error_cnt);
+    channel.LSR = LSR_CLEAR;
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    channel.TDL = TDL_CLEAR;
 }
 
 _eTPU_thread SPI_master::InitTCR2(_eTPU_matches_disabled)
@@ -212,6 +911,14 @@ _eTPU_thread SPI_master::InitTCR2(_eTPU_matches_disabled)
     channel.TBSA = TBS_M2C2GE;
     channel.TBSB = TBS_M2C2GE;
     channel.FLAG0 = 1;
+    _use_TCR2 = 1;
+    chan -= 1;
+    channel.TBSA = TBS_M2C2GE;
+    channel.TBSB = TBS_M2C2GE;
+    chan += 2;
+    channel.TBSA = TBS_M2C2GE;
+    channel.TBSB = TBS_M2C2GE;
+    chan -= 1;
 
     CommonInit();
 }
@@ -230,20 +937,82 @@ _eTPU_fragment SPI_master::CommonRun()
     channel.MRLA = MRL_CLEAR;
     channel.MRLB = MRL_CLEAR;
     channel.TDL = TDL_CLEAR;
+    _trailing_state = SPI_MASTER_TRAILING_CLOCK;
+    channel.FLAG1 = 0;
+
+    _bit_count_current = _bit_count;  /* RECORD BIT_COUNT AS BIT_COUNT_CURRENT FOR CALCULATIONS */
+    if (_xfer_mode != SPI_MASTER_XFER_WORD)
+    {
+        if (_xfer_mode == SPI_MASTER_XFER_BURST)
+        {
+            /* command word first */
+            _burst->xfer.index = 0;
+            _bit_count_current = _burst->cmd_bit_count;
+        }
+        else if (_xfer_mode == SPI_MASTER_XFER_CHAIN)
+        {
+            _chain->xfer.index = 0;
+            _chain->start_time = erta;
+            _data_out_reg = _chain->entry[0].data_out;
+        }
+        else
+        {
+            _stream->xfer.index = 0;
+            _stream->frame_index = 0;
+            _data_out_reg = _stream->buf[0];
+        }
+    }
 
     if (_slave_select_chan != 0xff)
     {
         uint8_t tmp;
         
-        _slave_select_end = 0;
-        erta += _slave_select_delay;
-        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
-
         tmp = chan;
+        if (_ss_release_chan != 0xff)
+        {
+            /* previous release may not have happened yet - if so, start
+               half a bit after it */
+            chan = _ss_release_chan;
+            _ss_release_chan = 0xff;
+            if (!IsMatchBOccurred())
+            {
+                erta = _ss_release_time + _half_period;
+            }
+        }
+        if (_ss_addr_bit_count != 0)
+        {
+            /* drive the decoder address half a bit ahead of its enable */
+            int8_t i;
+            uint8_t addr = _slave_select_addr;
+
+            chan = _ss_addr_chan;
+            #pragma wctl_loop_iterations 5
+            for (i = 0; i < _ss_addr_bit_count; i++)
+            {
+                if (addr & 1)
+                {
+                    channel.OPACA = OPAC_MATCH_HIGH;
+                }
+                else
+                {
+                    channel.OPACA = OPAC_MATCH_LOW;
+                }
+                channel.MRLA = MRL_CLEAR;
+                channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+                addr >>= 1;
+                chan += 1;
+            }
+            erta += _half_period;
+        }
+        /* assert slave select on its own match A */
         chan = _slave_select_chan;
-        channel.PIN = PIN_SET_LOW;
+        channel.MRLA = MRL_CLEAR;
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
         chan = tmp;
-    }
+
+        erta += _slave_select_delay;
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    }
     else
     {
         erta += _half_period;
@@ -251,7 +1020,13 @@ _eTPU_fragment SPI_master::CommonRun()
     }
 
     _data_out_shift_reg = _data_out_reg;
-     if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
+    if (_crc != 0)
+    {
+        _crc->out = _crc->init;
+        _crc->in = _crc->init;
+        _crc->phase = SPI_MASTER_CRC_PHASE_DATA;
+    }
+    if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
     {
         /* move to MOSI channel */
         chan += 1;
@@ -271,14 +1046,20 @@ _eTPU_fragment SPI_master::CommonRun()
         if (CC.C != 0)
         {
             channel.PIN = PIN_SET_HIGH;
+            if (_crc != 0)
+            {
+                _crc->out ^= 0x800000;
+            }
         }
         else
         {
             channel.PIN = PIN_SET_LOW;
         }
+        if (_crc != 0)
+        {
+            CRCOut();
+        }
     }
-
-    _bit_count_current = _bit_count;  /* RECORD BIT_COUNT AS BIT_COUNT_CURRENT FOR CALCULATIONS */
 }
 
 _eTPU_thread SPI_master::RunTCR2(_eTPU_matches_disabled)
@@ -288,46 +1069,138 @@ _eTPU_thread SPI_master::RunTCR2(_eTPU_matches_disabled)
     CommonRun();
 }
 
-_eTPU_thread SPI_master::ClockLeadingLSB(_eTPU_matches_enabled)
+/* SCLK working threads - one set per clock phase and shift direction, so
+   no mode tests are made per bit */
+
+_eTPU_thread SPI_master::ClockLeading_CPHA0_LSB(_eTPU_matches_enabled)
 {
     channel.MRLA = MRL_CLEAR;
-    
-    if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
+
+    /* CODE TO READ INPUT PIN - AND ADD DATA TO DATA_REG */
+    /* RECEIVE DATA  CHANNEL IS CHANNEL BELOW CLOCK */
+    chan -= 1;
+    _data_in_shift_reg >>= 1;
+    if (channel.PSTI == 1)
     {
-        /* CODE TO READ INPUT PIN - AND ADD DATA TO DATA_REG */
-        /* RECEIVE DATA  CHANNEL IS CHANNEL BELOW CLOCK */
-        chan -= 1;
-        _data_in_shift_reg >>= 1;
-        if (channel.PSTI == 1)
-        {
-            _data_in_shift_reg += 0x800000;
-        }
+        _data_in_shift_reg += 0x800000;
+    }
+
+    SetTrailingEdge();
+}
+
+_eTPU_thread SPI_master::ClockLeading_CPHA0_MSB(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
 
-        SetTrailingEdge();
+    /* CODE TO READ INPUT PIN - AND ADD DATA TO DATA_REG */
+    /* DATA IN CHANNEL IS CHANNEL BELOW CLOCK */
+    chan -= 1;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
+    {
+        _data_in_shift_reg += 1;
+    }
+
+    SetTrailingEdge();
+}
+
+_eTPU_thread SPI_master::ClockLeading_CPHA0_CRC(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
+
+    chan -= 1;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
+    {
+        _data_in_shift_reg += 1;
+        _crc->in ^= 0x800000;
+    }
+    CRCIn();
+
+    SetTrailingEdge();
+}
+
+_eTPU_thread SPI_master::ClockLeading_CPHA0_DLY(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
+
+    /* MISO is read by the Sample threads, in either direction */
+    chan -= 1;
+    ScheduleSample_CPHA0();
+}
+
+_eTPU_thread SPI_master::ClockLeading_CPHA1_LSB(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
+
+    /* setup trailing clock edge first */
+    ertb = erta + _half_period;    /* update ertb for next match B */
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+
+    _bit_count_current -= 1;
+
+    /* put data out on this edge */
+    chan += 1;
+    _data_out_shift_reg >>= 1;
+
+    if (CC.C != 0)
+    {
+        channel.PIN = PIN_SET_HIGH;
     }
     else
     {
-        /* setup trailing clock edge first */
-        ertb = erta + _half_period;    /* update ertb for next match B */
-        channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
-        
-        _bit_count_current -= 1;
+        channel.PIN = PIN_SET_LOW;
+    }
+}
 
-        /* put data out on this edge */
-        chan += 1;
-        _data_out_shift_reg >>= 1;
+_eTPU_thread SPI_master::ClockLeading_CPHA1_MSB(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
 
-        if (CC.C != 0)
-        {
-            channel.PIN = PIN_SET_HIGH;
-        }
-        else
-        {
-            channel.PIN = PIN_SET_LOW;
-        }
+    /* setup trailing clock edge first */
+    ertb = erta + _half_period;    /* update ertb for next match B */
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+
+    _bit_count_current -= 1;
+
+    /* put data out on this edge */
+    chan += 1;
+    _data_out_shift_reg <<= 1;
+
+    if (CC.C != 0)
+    {
+        channel.PIN = PIN_SET_HIGH;
+    }
+    else
+    {
+        channel.PIN = PIN_SET_LOW;
     }
 }
 
+_eTPU_thread SPI_master::ClockLeading_CPHA1_CRC(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
+
+    ertb = erta + _half_period;
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+
+    _bit_count_current -= 1;
+
+    chan += 1;
+    _data_out_shift_reg <<= 1;
+
+    if (CC.C != 0)
+    {
+        channel.PIN = PIN_SET_HIGH;
+        _crc->out ^= 0x800000;
+    }
+    else
+    {
+        channel.PIN = PIN_SET_LOW;
+    }
+    CRCOut();
+}
+
 _eTPU_fragment SPI_master::SetTrailingEdge()
 {
     chan += 1;
@@ -339,133 +1212,352 @@ _eTPU_fragment SPI_master::SetTrailingEdge()
     _bit_count_current -= 1;
 }
 
-_eTPU_thread SPI_master::ClockLeadingMSB(_eTPU_matches_enabled)
+_eTPU_fragment SPI_master::ScheduleSample_CPHA0()
+{
+    /* on the MISO channel - set both matches to the sample time, then
+       carry on as if the bit had been read */
+    erta = erta + _miso_sample_delay;
+    ertb = erta;
+    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+    erta = erta - _miso_sample_delay;
+
+    SetTrailingEdge();
+}
+
+_eTPU_fragment SPI_master::ScheduleSample_CPHA1()
+{
+    /* on the MISO channel - set both matches to the sample time, then
+       carry on as if the bit had been read */
+    ertb = ertb + _miso_sample_delay;
+    erta = ertb;
+    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+    ertb = ertb - _miso_sample_delay;
+
+    ReadData_CPHA1();
+}
+
+_eTPU_thread SPI_master::SampleLSB(_eTPU_matches_enabled)
+{
+    /* MISO channel, PSS is the pin state at the start of this thread - the
+       match time plus the service latency */
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    _data_in_shift_reg >>= 1;
+    if (channel.PSS == 1)
+    {
+        _data_in_shift_reg += 0x800000;
+    }
+    if (_bit_count_current == 0)
+    {
+        LastSample();
+    }
+}
+
+_eTPU_thread SPI_master::SampleMSB(_eTPU_matches_enabled)
 {
+    /* MISO channel, PSS is the pin state at the start of this thread - the
+       match time plus the service latency */
     channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSS == 1)
+    {
+        _data_in_shift_reg += 1;
+    }
+    if (_bit_count_current == 0)
+    {
+        LastSample();
+    }
+}
 
-    if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
+_eTPU_thread SPI_master::SampleCRC(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSS == 1)
     {
-        /* CODE TO READ INPUT PIN - AND ADD DATA TO DATA_REG */
-        /* DATA IN CHANNEL IS CHANNEL BELOW CLOCK */
-        chan -= 1;
-        _data_in_shift_reg <<= 1;
-        if (channel.PSTI == 1)
-        {
-            _data_in_shift_reg += 1;
-        }
+        _data_in_shift_reg += 1;
+        _crc->in ^= 0x800000;
+    }
+    CRCIn();
+    if (_bit_count_current == 0)
+    {
+        LastSample();
+    }
+}
 
-        SetTrailingEdge();
+_eTPU_thread SPI_master::SampleLink(_eTPU_matches_enabled)
+{
+    /* SCLK channel, linked by the last Sample thread after the last edge */
+    channel.LSR = LSR_CLEAR;
+    if (_trailing_state != SPI_MASTER_TRAILING_SAMPLE)
+    {
+        SPI_MASTER_COUNT(error_cnt);
+        return;
+    }
+    _trailing_state = SPI_MASTER_TRAILING_CLOCK;
+    FinishWord();
+}
+
+void SPI_master::LastSample()
+{
+    /* MISO channel - the last bit of the word (or of its data part) is in */
+    if (_trailing_state == SPI_MASTER_TRAILING_SAMPLE)
+    {
+        /* the last edge has been, the SCLK channel finishes the word */
+        link = chan + 1;
     }
     else
     {
-        /* setup trailing clock edge first */
-        ertb = erta + _half_period;    /* update ertb for next match B */
-        channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+        _trailing_state = SPI_MASTER_TRAILING_SAMPLED;
+    }
+}
 
-        _bit_count_current -= 1;
-        
-        /* put data out on this edge */
+_eTPU_thread SPI_master::TrailingEvent(_eTPU_matches_enabled)
+{
+    /* SCLK channel, flagged by FLAG1 - whatever follows flags itself again */
+    channel.MRLB = MRL_CLEAR;
+    channel.FLAG1 = 0;
+
+    TrailingStateChange();
+}
+
+_eTPU_thread SPI_master::ClockTrailing_CPHA0_LSB(_eTPU_matches_enabled)
+{
+    channel.MRLB = MRL_CLEAR;
+
+    if (_bit_count_current != 0)
+    {
+        /* PUT data_out ON DATA OUT PIN */
         chan += 1;
-        _data_out_shift_reg <<= 1;
+        _data_out_shift_reg >>= 1;
 
-        if (CC.C != 0)
-        {
-            channel.PIN = PIN_SET_HIGH;
-        }
-        else
+        WriteData_CPHA0();
+    }
+    else
+    {
+        if (_miso_sample_delay != 0)
         {
-            channel.PIN = PIN_SET_LOW;
+            LastEdge();
         }
+        FinishWord();
     }
 }
 
-_eTPU_thread SPI_master::ClockTrailingLSB(_eTPU_matches_enabled)
+_eTPU_thread SPI_master::ClockTrailing_CPHA0_MSB(_eTPU_matches_enabled)
 {
     channel.MRLB = MRL_CLEAR;
 
-    if (_slave_select_end == 1)
+    if (_bit_count_current != 0)
     {
-        _slave_select_end = 0;
-        /* this only occurs on a final match to disable slave select */
-        chan = _slave_select_chan;
-        channel.PIN = PIN_SET_HIGH;
-        channel.CIRC = CIRC_INT_FROM_SERVICED;
-        channel.CIRC = CIRC_DATA_FROM_SERVICED;
-        return;
-    }
+        /* PUT data_out ON DATA OUT PIN */
+        chan += 1;
+        _data_out_shift_reg <<= 1;
 
-    if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
+        WriteData_CPHA0();
+    }
+    else
     {
-        if (_bit_count_current != 0)
+        if (_miso_sample_delay != 0)
         {
-            /* PUT data_out ON DATA OUT PIN */
-            chan += 1;
-            _data_out_shift_reg >>= 1;
-
-            WriteData_CPHA0();
-        }
-        else
-        {
-            FinishWord();
+            LastEdge();
         }
+        FinishWord();
+    }
+}
+
+_eTPU_thread SPI_master::ClockTrailing_CPHA0_CRC(_eTPU_matches_enabled)
+{
+    channel.MRLB = MRL_CLEAR;
+
+    if (_bit_count_current != 0)
+    {
+        chan += 1;
+        _data_out_shift_reg <<= 1;
+
+        WriteData_CPHA0_CRC();
     }
     else
     {
-        /* need to sample input */
-        chan -= 1;
-        _data_in_shift_reg >>= 1;
-        if (channel.PSTI == 1)
+        if (_miso_sample_delay != 0)
         {
-            _data_in_shift_reg += 0x800000;
+            LastEdge();
         }
+        FinishWord();
+    }
+}
 
-        ReadData_CPHA1();
+_eTPU_thread SPI_master::ClockTrailing_CPHA1_LSB(_eTPU_matches_enabled)
+{
+    channel.MRLB = MRL_CLEAR;
+
+    /* need to sample input */
+    chan -= 1;
+    _data_in_shift_reg >>= 1;
+    if (channel.PSTI == 1)
+    {
+        _data_in_shift_reg += 0x800000;
     }
+
+    ReadData_CPHA1();
 }
 
-_eTPU_thread SPI_master::ClockTrailingMSB(_eTPU_matches_enabled)
+_eTPU_thread SPI_master::ClockTrailing_CPHA1_MSB(_eTPU_matches_enabled)
 {
     channel.MRLB = MRL_CLEAR;
 
-    if (_slave_select_end == 1)
+    /* need to sample input */
+    chan -= 1;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
     {
-        _slave_select_end = 0;
-        /* this only occurs on a final match to disable slave select */
-        chan = _slave_select_chan;
-        channel.PIN = PIN_SET_HIGH;
-        channel.CIRC = CIRC_INT_FROM_SERVICED;
-        channel.CIRC = CIRC_DATA_FROM_SERVICED;
-        return;
+        _data_in_shift_reg += 1;
     }
 
-    if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
+    ReadData_CPHA1();
+}
+
+_eTPU_thread SPI_master::ClockTrailing_CPHA1_CRC(_eTPU_matches_enabled)
+{
+    channel.MRLB = MRL_CLEAR;
+
+    chan -= 1;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
     {
-        if (_bit_count_current != 0)
-        {
-            /* PUT data_out ON DATA OUT PIN */
+        _data_in_shift_reg += 1;
+        _crc->in ^= 0x800000;
+    }
+    CRCIn();
 
-            chan += 1;
-            _data_out_shift_reg <<= 1;
+    ReadData_CPHA1();
+}
 
-            WriteData_CPHA0();
-        }
-        else
-        {
-            FinishWord();
-        }
+_eTPU_thread SPI_master::ClockTrailing_CPHA1_DLY(_eTPU_matches_enabled)
+{
+    channel.MRLB = MRL_CLEAR;
+
+    /* MISO is read by the Sample threads, in either direction */
+    chan -= 1;
+    ScheduleSample_CPHA1();
+}
+
+/* DDR clock edge threads - a bit is read, and the next one scheduled out,
+   on every edge */
+
+_eTPU_thread SPI_master::ClockLeading_DDR_LSB(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
+
+    /* the trailing edge always follows, _bit_count is even */
+    ertb = erta + _half_period;
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+    _bit_count_current -= 1;
+
+    chan -= 1;
+    _data_in_shift_reg >>= 1;
+    if (channel.PSTI == 1)
+    {
+        _data_in_shift_reg += 0x800000;
     }
-    else
+
+    erta = erta + (_half_period >> 1);
+    chan += 2;
+    _data_out_shift_reg >>= 1;
+    WriteData_DDR();
+}
+
+_eTPU_thread SPI_master::ClockLeading_DDR_MSB(_eTPU_matches_enabled)
+{
+    channel.MRLA = MRL_CLEAR;
+
+    /* the trailing edge always follows, _bit_count is even */
+    ertb = erta + _half_period;
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+    _bit_count_current -= 1;
+
+    chan -= 1;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
     {
-        /* need to sample input */
-        chan -= 1;
-        _data_in_shift_reg <<= 1;
-        if (channel.PSTI == 1)
-        {
-            _data_in_shift_reg += 1;
-        }
+        _data_in_shift_reg += 1;
+    }
 
-        ReadData_CPHA1();
+    erta = erta + (_half_period >> 1);
+    chan += 2;
+    _data_out_shift_reg <<= 1;
+    WriteData_DDR();
+}
+
+_eTPU_thread SPI_master::ClockTrailing_DDR_LSB(_eTPU_matches_enabled)
+{
+    channel.MRLB = MRL_CLEAR;
+
+    chan -= 1;
+    _data_in_shift_reg >>= 1;
+    if (channel.PSTI == 1)
+    {
+        _data_in_shift_reg += 0x800000;
+    }
+    chan += 1;
+
+    _bit_count_current -= 1;
+    if (_bit_count_current == 0)
+    {
+        FinishWord();
+    }
+    erta = ertb + _half_period;
+    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+
+    erta = ertb + (_half_period >> 1);
+    chan += 1;
+    _data_out_shift_reg >>= 1;
+    WriteData_DDR();
+}
+
+_eTPU_thread SPI_master::ClockTrailing_DDR_MSB(_eTPU_matches_enabled)
+{
+    channel.MRLB = MRL_CLEAR;
+
+    chan -= 1;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
+    {
+        _data_in_shift_reg += 1;
+    }
+    chan += 1;
+
+    _bit_count_current -= 1;
+    if (_bit_count_current == 0)
+    {
+        FinishWord();
+    }
+    erta = ertb + _half_period;
+    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+
+    erta = ertb + (_half_period >> 1);
+    chan += 1;
+    _data_out_shift_reg <<= 1;
+    WriteData_DDR();
+}
+
+_eTPU_fragment SPI_master::WriteData_DDR()
+{
+    /* on the MOSI channel - CC.C is the next bit, driven at erta (a quarter
+       bit after the edge) by match A */
+    if (CC.C != 0)
+    {
+        channel.OPACA = OPAC_MATCH_HIGH;
+    }
+    else
+    {
+        channel.OPACA = OPAC_MATCH_LOW;
     }
+    channel.MRLA = MRL_CLEAR;
+    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
 }
 
 _eTPU_fragment SPI_master::WriteData_CPHA0()
@@ -483,6 +1575,23 @@ _eTPU_fragment SPI_master::WriteData_CPHA0()
     channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
 }
 
+_eTPU_fragment SPI_master::WriteData_CPHA0_CRC()
+{
+    if (CC.C != 0)
+    {
+        channel.PIN = PIN_SET_HIGH;
+        _crc->out ^= 0x800000;
+    }
+    else
+    {
+        channel.PIN = PIN_SET_LOW;
+    }
+    CRCOut();
+    chan -= 1;
+    erta = ertb + _half_period;      /* 2nd clock edge follows 1st */
+    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+}
+
 _eTPU_fragment SPI_master::ReadData_CPHA1()
 {
     /* set up next clock pulse if not done yet */        
@@ -495,34 +1604,370 @@ _eTPU_fragment SPI_master::ReadData_CPHA1()
     else
     {
         chan += 1;
+        if (_miso_sample_delay != 0)
+        {
+            LastEdge();
+        }
         FinishWord();
     }
 }
 
+_eTPU_fragment SPI_master::LastEdge()
+{
+    /* SCLK channel, MISO sample delay - the word waits for its last sample */
+    if (_trailing_state == SPI_MASTER_TRAILING_SAMPLED)
+    {
+        _trailing_state = SPI_MASTER_TRAILING_CLOCK;
+        FinishWord();
+    }
+    _trailing_state = SPI_MASTER_TRAILING_SAMPLE;
+}
+
 _eTPU_fragment SPI_master::FinishWord()
 {
-    _data_in_reg = _data_in_shift_reg;
+    if (_crc != 0)
+    {
+        SPI_master_crc_t *crc = _crc;
+
+        if (crc->phase == SPI_MASTER_CRC_PHASE_DATA)
+        {
+            StartCRC();
+        }
+        /* data in was captured when the CRC phase started - a mismatch is
+           sticky until read, the host finds it at the channel interrupt that
+           ends the word, transfer or half ring */
+        if (crc->in != crc->residue)
+        {
+            crc->error = 1;
+        }
+    }
+    else
+    {
+        _data_in_reg = _data_in_shift_reg;
+    }
+    if (_xfer_mode != SPI_MASTER_XFER_WORD)
+    {
+        if (_xfer_mode == SPI_MASTER_XFER_BURST)
+        {
+            SPI_master_burst_t *burst = _burst;
+
+            /* index 0 is the command, its data in is not kept */
+            if (burst->xfer.index != 0)
+            {
+                burst->rx_buf[burst->xfer.index - 1] = _data_in_reg;
+            }
+            if (burst->xfer.index != burst->xfer.cnt)
+            {
+                burst->xfer.index += 1;
+                _data_out_shift_reg = burst->dummy;
+                NextWord();
+            }
+        }
+        else if (_xfer_mode == SPI_MASTER_XFER_CHAIN)
+        {
+            SPI_master_chain_t *chain = _chain;
+
+            chain->entry[chain->xfer.index].data_in = _data_in_reg;
+            if (++chain->xfer.index != chain->xfer.cnt)
+            {
+                _data_out_shift_reg = chain->entry[chain->xfer.index].data_out;
+                NextWord();
+            }
+        }
+        else
+        {
+            SPI_master_stream_t *stream = _stream;
+
+            StreamStore();
+            if ((stream->xfer.run != 0) || (stream->frame_index != 0))
+            {
+                _data_out_shift_reg = stream->buf[stream->xfer.index];
+                NextWord();
+            }
+            /* stopped at a frame end - StreamStore has signalled the host and
+               released the frame sync, there is no word tail */
+            return;
+        }
+    }
     if (_slave_select_chan != 0xff)
     {
-        /* set up to disable slave select - hold for half a bit */
-        _slave_select_end = 1;
+        uint8_t sclk_chan = chan;
+
+        /* release slave select half a bit after the last edge, on its own
+           match B - no further service is needed */
         ertb = ertb + _half_period;
+        _ss_release_time = ertb;
+        _ss_release_chan = _slave_select_chan;
+        chan = _slave_select_chan;
+        channel.MRLB = MRL_CLEAR;
         channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
-        return;
+        chan = sclk_chan;
+    }
+    /* counted before ChainDone, a fragment that ends the thread */
+    if (_rx_full != 0)
+    {
+        SPI_MASTER_COUNT(rx_overrun_cnt);
+    }
+    _rx_full = 1;
+    if (_xfer_mode == SPI_MASTER_XFER_CHAIN)
+    {
+        ChainDone();
     }
     channel.CIRC = CIRC_INT_FROM_SERVICED;
     channel.CIRC = CIRC_DATA_FROM_SERVICED;
+    if (_angle_table_cnt != 0)
+    {
+        NextAngle();
+    }
+}
+
+void SPI_master::StreamStore()
+{
+    SPI_master_stream_t *stream = _stream;
+    uint8_t sclk_chan;
+
+    /* data in replaces the word just sent */
+    stream->buf[stream->xfer.index] = _data_in_reg;
+    if (++stream->xfer.index == stream->xfer.cnt)
+    {
+        stream->xfer.index = 0;
+    }
+    if (++stream->frame_index == stream->frame_cnt)
+    {
+        stream->frame_index = 0;
+    }
+    if ((stream->xfer.index == 0) || (stream->xfer.index == (stream->xfer.cnt >> 1)))
+    {
+        /* half the ring is done, the host reads and refills it */
+        if (_rx_full != 0)
+        {
+            SPI_MASTER_COUNT(rx_overrun_cnt);
+        }
+        _rx_full = 1;
+        if (_tx_fresh == 0)
+        {
+            SPI_MASTER_COUNT(tx_underrun_cnt);
+        }
+        _tx_fresh = 0;
+        channel.CIRC = CIRC_INT_FROM_SERVICED;
+    }
+    else if ((stream->frame_index == 0) && (stream->xfer.run == 0))
+    {
+        /* stopped at a frame end inside a half ring - the host reads the
+           part up to xfer.index */
+        if (_rx_full != 0)
+        {
+            SPI_MASTER_COUNT(rx_overrun_cnt);
+        }
+        _rx_full = 1;
+        channel.CIRC = CIRC_INT_FROM_SERVICED;
+    }
+
+    /* frame sync edges at this word boundary (ertb) - released after the
+       first word of a frame, asserted again at the next frame if running */
+    if (_slave_select_chan != 0xff)
+    {
+        sclk_chan = chan;
+        chan = _slave_select_chan;
+        if (stream->frame_index == 1)
+        {
+            channel.MRLB = MRL_CLEAR;
+            channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+        }
+        else if ((stream->frame_index == 0) && (stream->xfer.run != 0))
+        {
+            erta = ertb;
+            channel.MRLA = MRL_CLEAR;
+            channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+        }
+        chan = sclk_chan;
+    }
+}
+
+void SPI_master::CRCOut()
+{
+    /* one CRC step, the data bit already added into the top bit */
+    if ((_crc->out & 0x800000) != 0)
+    {
+        _crc->out = (_crc->out << 1) ^ _crc->poly;
+    }
+    else
+    {
+        _crc->out <<= 1;
+    }
+}
+
+void SPI_master::CRCIn()
+{
+    if ((_crc->in & 0x800000) != 0)
+    {
+        _crc->in = (_crc->in << 1) ^ _crc->poly;
+    }
+    else
+    {
+        _crc->in <<= 1;
+    }
+}
+
+_eTPU_fragment SPI_master::StartCRC()
+{
+    SPI_master_crc_t *crc = _crc;
+
+    /* data bits are done, append the CRC bits to the word */
+    crc->phase = SPI_MASTER_CRC_PHASE_CRC;
+    _data_in_reg = _data_in_shift_reg;
+    _bit_count_current = crc->bit_count;
+    _data_out_shift_reg = crc->out ^ crc->xorout;
+    if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
+    {
+        chan += 1;
+        _data_out_shift_reg <<= 1;
+
+        WriteData_CPHA0_CRC();
+    }
+    else
+    {
+        erta = ertb + _half_period;      /* next leading edge puts out first CRC bit */
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    }
+}
+
+_eTPU_fragment SPI_master::NextWord()
+{
+    /* continue clocking without a gap, slave select stays asserted;
+       _data_out_shift_reg has been loaded with the next word */
+    if (_crc != 0)
+    {
+        _crc->out = _crc->init;
+        _crc->in = _crc->init;
+        _crc->phase = SPI_MASTER_CRC_PHASE_DATA;
+    }
+    _bit_count_current = _bit_count;
+    if (channel.FM0 == SPI_MASTER_CPHA_0_FM0)
+    {
+        chan += 1;
+        if (channel.FM1 == SPI_MASTER_SHIFT_DIR_LSB_FM1)
+        {
+            _data_out_shift_reg  >>= 1;       /* SHIFT LSB FIRST */
+        }
+        else
+        {
+            _data_out_shift_reg  <<= 1;       /* SHIFT MSB FIRST */
+        }
+
+        if (_crc != 0)
+        {
+            WriteData_CPHA0_CRC();
+        }
+        WriteData_CPHA0();
+    }
+    else
+    {
+        erta = ertb + _half_period;      /* next leading edge puts out first bit */
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    }
+}
+
+_eTPU_fragment SPI_master::TrailingStateChange()
+{
+    /* FLAG1 has been cleared */
+    if (_trailing_state == SPI_MASTER_TRAILING_REFRESH)
+    {
+        /* periodic chain refresh, timed from the previous start */
+        _trailing_state = SPI_MASTER_TRAILING_CLOCK;
+        if ((_xfer_mode == SPI_MASTER_XFER_CHAIN) && (_chain->xfer.run != 0))
+        {
+            erta = ertb;
+            CommonRun();
+        }
+    }
+    else
+    {
+        AngleRun();
+    }
+}
+
+_eTPU_fragment SPI_master::ChainDone()
+{
+    SPI_master_chain_t *chain = _chain;
+    uint8_t sclk_chan;
+
+    /* whole chain shifted - pulse the latch from the slave select release
+       (ertb), both edges on matches of the latch channel */
+    if (chain->latch_chan != 0xff)
+    {
+        sclk_chan = chan;
+        chan = chain->latch_chan;
+        erta = ertb;
+        ertb = ertb + chain->latch_width;
+        channel.MRLA = MRL_CLEAR;
+        channel.MRLB = MRL_CLEAR;
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+        channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+        chan = sclk_chan;
+    }
+    channel.CIRC = CIRC_INT_FROM_SERVICED;
+    channel.CIRC = CIRC_DATA_FROM_SERVICED;
+    if (chain->xfer.run != 0)
+    {
+        _trailing_state = SPI_MASTER_TRAILING_REFRESH;
+        channel.FLAG1 = 1;
+        ertb = chain->start_time + chain->refresh_period;
+        channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+    }
+}
+
+_eTPU_fragment SPI_master::AngleRun()
+{
+    /* angle target reached, start the transfer - clocking is done on TCR1 */
+    channel.TBSB = TBS_M1C1GE;
+    _trailing_state = SPI_MASTER_TRAILING_CLOCK;
+    _data_out_reg = _angle_table[_angle_table_index].data_out;
+    _slave_select_chan = _angle_table[_angle_table_index].slave_select_chan;
+    _slave_select_addr = _angle_table[_angle_table_index].slave_select_addr;
+    erta = tcr1;
+
+    CommonRun();
+}
+
+_eTPU_fragment SPI_master::NextAngle()
+{
+    /* store the received data with the entry that started the transfer */
+    _angle_table[_angle_table_index].data_in = _data_in_reg;
+    if (++_angle_table_index == _angle_table_cnt)
+    {
+        _angle_table_index = 0;
+    }
+
+    ScheduleAngle();
+}
+
+_eTPU_fragment SPI_master::ScheduleAngle()
+{
+    /* the idle clock level is driven by match B, so the SCLK pin does not
+       change when the angle match occurs */
+    _trailing_state = SPI_MASTER_TRAILING_ANGLE;
+    channel.FLAG1 = 1;
+    channel.TBSB = TBS_M2C2GE;
+    ertb = _angle_table[_angle_table_index].angle;
+    channel.MRLB = MRL_CLEAR;
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
 }
 
 
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_INIT_TCR1_HSR", SPI_MASTER_INIT_TCR1_HSR
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_INIT_TCR2_HSR", SPI_MASTER_INIT_TCR2_HSR
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_RUN_HSR", SPI_MASTER_RUN_HSR
+#pragma export_autodef_macro "FS_ETPU_SPI_MASTER_COUNTERS_HSR", SPI_MASTER_COUNTERS_HSR
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_CPHA_0_FM0", SPI_MASTER_CPHA_0_FM0
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_CPHA_1_FM0", SPI_MASTER_CPHA_1_FM0
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_SHIFT_DIR_MSB_FM1", SPI_MASTER_SHIFT_DIR_MSB_FM1
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_SHIFT_DIR_LSB_FM1", SPI_MASTER_SHIFT_DIR_LSB_FM1
 #pragma export_autodef_macro "FS_ETPU_SPI_MASTER_MAX_SLAVE_SELECT_CNT", SPI_MASTER_MAX_SLAVE_SELECT_CNT
+#pragma export_autodef_macro "FS_ETPU_SPI_MASTER_XFER_WORD", SPI_MASTER_XFER_WORD
+#pragma export_autodef_macro "FS_ETPU_SPI_MASTER_XFER_BURST", SPI_MASTER_XFER_BURST
+#pragma export_autodef_macro "FS_ETPU_SPI_MASTER_XFER_CHAIN", SPI_MASTER_XFER_CHAIN
+#pragma export_autodef_macro "FS_ETPU_SPI_MASTER_XFER_STREAM", SPI_MASTER_XFER_STREAM
 
 /*********************************************************************
  *
@@ -16,16 +16,33 @@
 #define  SPI_SLAVE_INIT_HSR         1
 #define  SPI_SLAVE_INIT_SS_HSR      2
 #define  SPI_SLAVE_SET_DATA_HSR     7
+#define  SPI_SLAVE_COUNTERS_HSR     6
 /* Function Modes */
 #define  SPI_SLAVE_CPHA_0_FM0         0
 #define  SPI_SLAVE_CPHA_1_FM0         1
 #define  SPI_SLAVE_SHIFT_DIR_MSB_FM1  0
 #define  SPI_SLAVE_SHIFT_DIR_LSB_FM1  1
+/* SS inputs / virtual devices */
+#define  SPI_SLAVE_MAX_SS_CNT         4
+/* clock edges detected */
+#define  SPI_SLAVE_EDGE_BOTH          0
+#define  SPI_SLAVE_EDGE_RISING        1
+#define  SPI_SLAVE_EDGE_FALLING       2
+/* CRC phases */
+#define  SPI_SLAVE_CRC_PHASE_DATA     0
+#define  SPI_SLAVE_CRC_PHASE_CRC      1
+
+#define  SPI_SLAVE_SS_CHAN_BITS       6     /* per channel in _ss_chan_pack */
+#define  SPI_SLAVE_SS_CHAN_MASK       0x3f  /* also the unused entry */
+
+/* counters saturate rather than wrap, and are kept only if allocated */
+#define  SPI_SLAVE_COUNT(cnt)         if (_counters != 0) { if (_counters->cnt != 0xffffff) { _counters->cnt++; } }
 
 /***********************************/
 /* Verify performance requirements */
 /***********************************/
-#pragma verify_wctl  SPI_slave                 35  steps  10 rams
+/* the word end paths (register map, frames, virtual devices) */
+#pragma verify_wctl  SPI_slave                 100 steps  40 rams
 #pragma exclude_wctl SPI_slave::Init
 #pragma exclude_wctl SPI_slave::InitSSActive
 #pragma exclude_wctl SPI_slave::InitSSInactive
@@ -46,7 +63,119 @@ SS       - <config> [optional]
 
 interrupts
 - from SS chan when SS goes low (if SS exists)
-- from SCLK chan when word completes
+
+the SS channel is serviced on its transitions only, unless _ss_poll_period is
+non-zero, when its level is also checked at that period as a sanity
+check against a missed transition
+- from SCLK chan when word completes, after a CRC mismatch has set
+  crc->error (if CRC enabled)
+*/
+
+/*
+optional state : the frame holds only what every word needs.  The state of the
+CRC, register map, frames, long words, edge checks and counters is in DATA RAM
+blocks the host allocates only when the feature is configured, reached through
+_crc, _reg, _frame, _long, _edge and _counters - a null pointer disables the
+feature.
+*/
+
+/*
+register map : when _reg is non-zero (MSB first, no CRC), the first
+_seg_bit_count received bits of a word are a command - a register address, with
+reg->write_flag set for a write.  Once the command is in, the addressed
+reg->table entry is loaded as the rest of the word out, in the same word.  At
+the end of a write, the data bits received replace the entry.  No host action
+is needed per word.
+*/
+
+/*
+frames : when _frame is non-zero (SS required, no CRC), a frame lasts as long as
+SS is held active.  Received words are stored to frame->buf rather than
+interrupting, and on SS going inactive the exact frame length, including a
+trailing part word (also stored), is written to frame->bit_cnt and a single
+interrupt is raised from the SS channel.  Words beyond frame->word_max are
+counted but not stored.
+*/
+
+/*
+virtual devices : up to SPI_SLAVE_MAX_SS_CNT SS channels (_ss_chan_pack, 6 bits
+each, device 0 lowest) share the channel frame and the one set of SCLK threads.
+With _ss_cnt > 1 each SS is a device with its own data out and in registers, an
+entry of the _dev_buf table - the selected device's data out register is loaded
+on select and before each word, and each word in is stored to its device's
+register.  _data_in_index is the device of the last word in.
+*/
+
+/*
+long words : when _long is non-zero, a word of more than 24 bits (_bit_count up
+to 48) is shifted as two chained segments - a leading segment of _seg_bit_count
+bits, then 24 bits.  The leading segment goes out from long->data_out_lead
+(left-justified like _data_out_reg) and comes in to long->data_in_lead, the last
+24 bits use _data_out_reg / _data_in_reg as usual.  The shift registers are
+reloaded once, at the segment boundary, so the per-bit threads are unchanged.
+Not used with CRC, the register map, frames or virtual devices.
+*/
+
+/*
+counters : when _counters is non-zero, rx_overrun_cnt counts words (frames) in
+before the host read the last one (_rx_full), tx_underrun_cnt words out the
+host had not refreshed (_tx_fresh, word at a time only - not with frames, the
+register map or virtual devices), timeout_cnt ClockTimeout hits, abort_cnt
+words cut short by SS going inactive (word mode) and error_cnt unexpected
+entries.  The counters HSR copies them to the snap_ set and clears them in one
+thread, giving the host a coherent snapshot.  Counters are 24-bit and saturate
+at 0xffffff; the host clears the block at init.
+*/
+
+/*
+glitch : when _edge is non-zero, each serviced SCLK edge is captured (erta)
+and, within a word, must be at least edge->min_spacing after the previous one
+(0 -> no check, branched past before the compare).  A closer edge is noise or a desync - the word, or frame, is
+dropped and counted in glitch_cnt.  With SS the rest of the select is ignored
+and reception resynchronizes on the next select (_resync is set until then, a
+dropped frame ends with frame->bit_cnt 0); without SS the next edge starts a
+new word.
+*/
+
+/*
+edge statistics : when edge->stats is set (the host sclk_period_enable), in
+spec edge to edge times within a word are kept as edge->min, edge->max and a
+running average edge->avg (1/8 weight per edge).  They cost about 12 steps per
+serviced edge, so they are off unless asked for; _edge is 0 unless the glitch
+check or the statistics are enabled.
+The host sets edge->restart to start over, the next edge then loads all three.
+Both edges are detected with _sample_edge SPI_SLAVE_EDGE_BOTH (an SCLK period
+is two edges), only one otherwise.
+*/
+
+/*
+timeout : one match A on the SCLK channel is armed at the first received bit of
+a word, _timeout after that edge, and cancelled (MRLE) when the word (and its
+CRC) completes, so the per-bit threads do not touch the match registers.  If it
+fires, ClockTimeout resets the slave to await a new word.
+*/
+
+/*
+CRC : when _crc is non-zero (MSB first only), a CRC is computed bit-serially
+over the data out and the data in.  crc->bit_count CRC bits (crc->out ^
+crc->xorout) follow each data word, and the CRC run over the received word and
+its CRC must equal crc->residue.  Registers are left-justified in 24 bits.
+A mismatch sets crc->error, which stays set until the host reads it.
+The host selects the SPI_slave_CPHAx_CRC entry table, so the CRC steps are
+made by their own clock edge threads and the other threads make no CRC test
+per bit.
+*/
+
+/*
+one bit per edge : the SPI_slave_EDGE_x entry tables have a single clock edge
+thread, which reads MOSI then drives the next MISO bit _miso_hold after the
+captured edge time on a MISO match B (at once if _miso_hold is 0).  The first
+bit is put out on select (as CPHA 0).  CRC is not used.  _sample_edge selects
+the edges detected:
+- SPI_SLAVE_EDGE_BOTH - DDR, for eTPU to eTPU links, a bit on both clock
+  edges.  _miso_hold keeps MISO stable while the master samples it.
+- SPI_SLAVE_EDGE_RISING/FALLING - standard SPI, only the sampling edge is
+  detected, so a bit costs one thread rather than two.
 */
 
 #if 0
@@ -62,6 +191,76 @@ typedef unsigned int32  uint32_t;
 #endif
 
 
+/* virtual device registers (fs_etpu_spi_slave_set/get_device_data) */
+typedef struct
+{
+    uint24_t    data_out;
+    uint24_t    data_in;
+} SPI_slave_dev_entry_t;
+
+typedef struct
+{
+    uint24_t    poly;
+    uint24_t    init;
+    uint24_t    xorout;
+    uint24_t    residue;
+    int24_t     bit_count;
+    int24_t     error;
+    uint24_t    out;
+    uint24_t    in;
+} SPI_slave_crc_t;
+
+typedef struct
+{
+    uint24_t    addr_mask;
+    uint24_t    write_flag;         /* command bit of a write, 0 -> read only */
+    uint24_t    align;              /* 1 << (24 - data bits) */
+    uint24_t    addr;
+    uint24_t    table[1];           /* left-justified data, sized by the host */
+} SPI_slave_reg_t;
+
+typedef struct
+{
+    int24_t     word_max;
+    int24_t     word_cnt;
+    int24_t     bit_cnt;            /* length of the last frame */
+    uint24_t    buf[1];             /* sized by the host */
+} SPI_slave_frame_t;
+
+typedef struct
+{
+    uint24_t    data_out_lead;      /* first bits out */
+    uint24_t    data_in_lead;       /* first bits in */
+    uint24_t    data_in_seg;
+} SPI_slave_long_t;
+
+typedef struct
+{
+    uint24_t    min_spacing;        /* 0 -> no glitch check */
+    uint24_t    last_edge;
+    int24_t     stats;              /* 0 -> glitch check only */
+    int24_t     restart;            /* set by the host, cleared on the next edge */
+    uint24_t    min;
+    uint24_t    max;
+    uint24_t    avg;
+} SPI_slave_edge_t;
+
+typedef struct
+{
+    uint24_t    rx_overrun_cnt;
+    uint24_t    tx_underrun_cnt;
+    uint24_t    timeout_cnt;
+    uint24_t    abort_cnt;
+    uint24_t    error_cnt;
+    uint24_t    glitch_cnt;
+    uint24_t    snap_rx_overrun_cnt;
+    uint24_t    snap_tx_underrun_cnt;
+    uint24_t    snap_timeout_cnt;
+    uint24_t    snap_abort_cnt;
+    uint24_t    snap_error_cnt;
+    uint24_t    snap_glitch_cnt;
+} SPI_slave_counters_t;
+
 _eTPU_class SPI_slave
 {
     /* channel frame */
@@ -77,10 +276,36 @@ public:
     int8_t      _MISO_chan;
     int8_t      _selected_flag;
 
+    int24_t     _ss_poll_period;    /* 0 -> SS is transition driven only */
+
+    int24_t     _miso_hold;         /* EDGE tables only, edge to MISO change */
+    int8_t      _sample_edge;       /* EDGE tables only */
+
+    SPI_slave_crc_t *_crc;          /* 0 -> CRC disabled */
+    SPI_slave_reg_t *_reg;          /* 0 -> register map disabled */
+    SPI_slave_frame_t *_frame;      /* 0 -> a word at a time */
+    SPI_slave_long_t *_long;        /* 0 -> words of up to 24 bits */
+    SPI_slave_edge_t *_edge;        /* 0 -> no edge checks */
+    SPI_slave_counters_t *_counters; /* 0 -> not counted */
+    int8_t      _seg_bit_count;     /* register command / long word lead bits, 0 -> none */
+
+    uint24_t    _ss_chan_pack;      /* SS channels, SPI_SLAVE_SS_CHAN_BITS each */
+    int8_t      _ss_cnt;            /* > 1 -> virtual devices */
+    int8_t      _ss_index;          /* device selected */
+    int8_t      _data_in_index;     /* device of the last word in */
+    SPI_slave_dev_entry_t *_dev_buf; /* virtual device registers, _ss_cnt > 1 */
+
+    int8_t      _rx_full;           /* cleared by the host when it reads */
+    int8_t      _tx_fresh;          /* set by the host when it writes */
+    uint24_t    _attach_sum;        /* host only - instance checksum for a warm restart */
+
 private:
     int8_t      _bit_count_current;
     uint24_t    _data_out_shift_reg;
     uint24_t    _data_in_shift_reg;
+    int8_t      _crc_phase;
+    _Bool       _reg_write;
+    _Bool       _resync;
 
     /* threads */
     
@@ -95,23 +320,61 @@ private:
     
     /* SCLK channel threads */
     _eTPU_thread SetData(_eTPU_matches_enabled);
-    _eTPU_thread ClockLeading(_eTPU_matches_enabled);
-    _eTPU_thread ClockTrailing(_eTPU_matches_enabled);
+    _eTPU_thread CountersSnapshot(_eTPU_matches_enabled);
+    _eTPU_thread ErrorHandler(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA0_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA0_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA1_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA1_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA0_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA0_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA1_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA1_MSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA0_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockLeading_CPHA1_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA0_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockTrailing_CPHA1_CRC(_eTPU_matches_enabled);
+    _eTPU_thread ClockEdge_LSB(_eTPU_matches_enabled);
+    _eTPU_thread ClockEdge_MSB(_eTPU_matches_enabled);
     _eTPU_thread ClockTimeout(_eTPU_matches_enabled);
 
     /* fragments */
     _eTPU_fragment CommonInitSS();
-    _eTPU_fragment ReadData();
+    _eTPU_fragment ReadDataLSB();
+    _eTPU_fragment ReadDataMSB();
+    _eTPU_fragment ReadDataCRC();
+    _eTPU_fragment ReadDataCount();
     _eTPU_fragment WriteData();
+    _eTPU_fragment WriteDataLSB();
+    _eTPU_fragment WriteDataMSB();
+    _eTPU_fragment WriteDataCRC();
+    _eTPU_fragment WriteDataPin();
+    _eTPU_fragment WriteDataPinMatch();
     
     /* methods */
-    /* none */
+    void RegisterCommand();
+    void RegisterWrite();
+    void WordStore();
+    void SegmentBoundary();
+    void CRCOut();
+    void CRCIn();
+    int8_t EdgeCheck();
+    void FrameEnd();
+    int8_t SelectIndex();
 
-    /* entry table(s) */
-    _eTPU_entry_table SPI_slave;
+    /* entry table(s) - one per clock phase and shift direction, with CRC
+       variants */
+    _eTPU_entry_table SPI_slave_CPHA0_MSB;
+    _eTPU_entry_table SPI_slave_CPHA0_LSB;
+    _eTPU_entry_table SPI_slave_CPHA1_MSB;
+    _eTPU_entry_table SPI_slave_CPHA1_LSB;
+    _eTPU_entry_table SPI_slave_CPHA0_CRC;
+    _eTPU_entry_table SPI_slave_CPHA1_CRC;
+    _eTPU_entry_table SPI_slave_EDGE_MSB;
+    _eTPU_entry_table SPI_slave_EDGE_LSB;
 };
 
-DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave, alternate, inputpin, autocfsr)
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_CPHA0_MSB, alternate, inputpin, autocfsr)
 {
 	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
 	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
@@ -119,21 +382,22 @@ DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave, alternate, inputpin, autocfsr)
 	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
 	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
 	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
-	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, SetData),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
 	
 	/* Clock leading transition detected */
-	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockLeading),
-	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockLeading),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockLeading_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockLeading_CPHA0_MSB),
 	/* prioritize edge over timeout */
-	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockLeading),
-	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockLeading),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockLeading_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockLeading_CPHA0_MSB),
 
 	/* Clock trailing transition detected */
-	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailing),
-	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailing),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailing_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailing_CPHA0_MSB),
 	/* prioritize edge over timeout */
-	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockTrailing),
-	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockTrailing),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockTrailing_CPHA0_MSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockTrailing_CPHA0_MSB),
 	
 	/* Clock timeout detected */
 	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
@@ -152,164 +416,873 @@ DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave, alternate, inputpin, autocfsr)
 	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
 
     /* invalid entries */	
-	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
-	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
 };
 
-
-_eTPU_thread SPI_slave::Init(_eTPU_matches_disabled)
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_CPHA0_LSB, alternate, inputpin, autocfsr)
 {
-    if (_use_TCR1 == TRUE)
-    {
-        channel.TBSA = TBS_M1C1GE;
-    }
-    else
-    {
-        channel.TBSA = TBS_M2C2GE;
-    }
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
+	
+	/* Clock leading transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockLeading_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockLeading_CPHA0_LSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockLeading_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockLeading_CPHA0_LSB),
 
-    channel.PDCM = PDCM_SM_ST;
-    channel.TBSA = TBSA_CLR_OBE;
-    channel.IPACA = IPAC_EITHER;
-    /* clear all latches */
-    channel.LSR = LSR_CLEAR;
-    channel.MRLA = MRL_CLEAR;
-    channel.MRLB = MRL_CLEAR;
-    channel.TDL = TDL_CLEAR;
-    channel.MTD = MTD_ENABLE;
-    /* set flag state, awaiting clock leading edge */
-    channel.FLAG0 = 0;
-    channel.FLAG1 = 0;
-    _bit_count_current = 0;
-    
-    /* configure data channels */
-    chan += 1;
-    channel.TBSA = TBSA_CLR_OBE;
-   
-    chan -= 2;
-    if (_selected_flag == 1)
-    {
-        channel.TBSA = TBSA_SET_OBE;
-    }
-    else
-    {
-        channel.TBSA = TBSA_CLR_OBE;
-    }
-}
+	/* Clock trailing transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailing_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailing_CPHA0_LSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockTrailing_CPHA0_LSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockTrailing_CPHA0_LSB),
+	
+	/* Clock timeout detected */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockTimeout),
+	
+	/* Select line transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, SelectTransDetected),
+	
+	/* Select line level check */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, SelectLevelCheck),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
 
-_eTPU_thread SPI_slave::InitSSActive(_eTPU_matches_disabled)
-{
-    _selected_flag = 1;
-    CommonInitSS();
-    
-}
+    /* invalid entries */	
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
+};
 
-_eTPU_thread SPI_slave::InitSSInactive(_eTPU_matches_disabled)
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_CPHA1_MSB, alternate, inputpin, autocfsr)
 {
-    _selected_flag = 0;
-    CommonInitSS();
-}
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
+	
+	/* Clock leading transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockLeading_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockLeading_CPHA1_MSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockLeading_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockLeading_CPHA1_MSB),
 
-_eTPU_fragment SPI_slave::CommonInitSS()
-{
-    channel.TBSA = TBSA_CLR_OBE;
-    channel.PDCM = PDCM_SM_ST;
-    channel.TBSA = TBS_M1C1GE;
-    channel.FLAG0 = 1;
-    channel.IPACA = IPAC_EITHER; /* detect all transitions */
-    channel.LSR = LSR_CLEAR;
-    channel.MRLA = MRL_CLEAR;
-    channel.MRLB = MRL_CLEAR;
-    channel.TDL = TDL_CLEAR;
-    
-    /* start pin level polling */
-    erta = tcr1 + _timeout;
-    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
-    channel.MTD = MTD_ENABLE;
-}
+	/* Clock trailing transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailing_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailing_CPHA1_MSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockTrailing_CPHA1_MSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockTrailing_CPHA1_MSB),
+	
+	/* Clock timeout detected */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockTimeout),
+	
+	/* Select line transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, SelectTransDetected),
+	
+	/* Select line level check */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, SelectLevelCheck),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
 
+    /* invalid entries */	
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
+};
 
-/* Slave select channel threads */
-_eTPU_thread SPI_slave::SelectTransDetected(_eTPU_matches_enabled)
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_CPHA1_LSB, alternate, inputpin, autocfsr)
 {
-    channel.TDL = TDL_CLEAR;
-    channel.CIRC = CIRC_INT_FROM_SERVICED;
-    if (channel.PSTI == 0)
-    {
-        _selected_flag = 1;
-        _bit_count_current = 0;
-        chan = _MISO_chan;
-        channel.TBSA = TBSA_SET_OBE;
-        channel.CIRC = CIRC_INT_FROM_SERVICED;
-        /* need to put first output bit on pin depending upon clock phase */
-        if (channel.FM0 == 0)
-        {
-            WriteData();
-        }
-    }
-    else
-    {
-        _selected_flag = 0;
-        chan = _MISO_chan;
-        channel.TBSA = TBSA_CLR_OBE;
-    }
-}
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
+	
+	/* Clock leading transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockLeading_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockLeading_CPHA1_LSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockLeading_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockLeading_CPHA1_LSB),
 
-_eTPU_thread SPI_slave::SelectLevelCheck(_eTPU_matches_enabled)
-{
-    /* continue polling */
-    erta += _timeout;
-    channel.MRLA = MRL_CLEAR;
-    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
-    
-    if (channel.PSTI == 0)
-    {
-        if (_selected_flag == 0)
-        {
-            _selected_flag = 1;
-            _bit_count_current = 0;
-            chan = _MISO_chan;
-            channel.TBSA = TBSA_SET_OBE;
-            channel.CIRC = CIRC_INT_FROM_SERVICED;
-            /* need to put first output bit on pin depending upon clock phase */
-            if (channel.FM0 == 0)
-            {
-                WriteData();
-            }
-        }
-    }
-    else
-    {
-        if (_selected_flag == 1)
-        {
-            _selected_flag = 0;
-            chan = _MISO_chan;
-            channel.TBSA = TBSA_CLR_OBE;
-            channel.CIRC = CIRC_INT_FROM_SERVICED;
-        }
-    }
-}
+	/* Clock trailing transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailing_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailing_CPHA1_LSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockTrailing_CPHA1_LSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockTrailing_CPHA1_LSB),
+	
+	/* Clock timeout detected */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockTimeout),
+	
+	/* Select line transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, SelectTransDetected),
+	
+	/* Select line level check */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, SelectLevelCheck),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
+
+    /* invalid entries */	
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
+};
+
+/* CRC - MSB first only */
+
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_CPHA0_CRC, alternate, inputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
+	
+	/* Clock leading transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockLeading_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockLeading_CPHA0_CRC),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockLeading_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockLeading_CPHA0_CRC),
+
+	/* Clock trailing transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailing_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailing_CPHA0_CRC),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockTrailing_CPHA0_CRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockTrailing_CPHA0_CRC),
+	
+	/* Clock timeout detected */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockTimeout),
+	
+	/* Select line transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, SelectTransDetected),
+	
+	/* Select line level check */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, SelectLevelCheck),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
+
+    /* invalid entries */	
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
+};
+
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_CPHA1_CRC, alternate, inputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
+	
+	/* Clock leading transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockLeading_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockLeading_CPHA1_CRC),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockLeading_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockLeading_CPHA1_CRC),
+
+	/* Clock trailing transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockTrailing_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockTrailing_CPHA1_CRC),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockTrailing_CPHA1_CRC),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockTrailing_CPHA1_CRC),
+	
+	/* Clock timeout detected */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockTimeout),
+	
+	/* Select line transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, SelectTransDetected),
+	
+	/* Select line level check */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, SelectLevelCheck),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
+
+    /* invalid entries */	
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
+};
+
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_EDGE_MSB, alternate, inputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
+	
+	/* Clock transition detected - each detected edge */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockEdge_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockEdge_MSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockEdge_MSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockEdge_MSB),
+
+	/* FLAG1 is not used by the EDGE tables */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockEdge_MSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockEdge_MSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockEdge_MSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockEdge_MSB),
+	
+	/* Clock timeout detected */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockTimeout),
+	
+	/* Select line transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, SelectTransDetected),
+	
+	/* Select line level check */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, SelectLevelCheck),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
+
+    /* invalid entries */	
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
+};
+
+DEFINE_ENTRY_TABLE(SPI_slave, SPI_slave_EDGE_LSB, alternate, inputpin, autocfsr)
+{
+	/*           HSR    LSR M1 M2 PIN F0 F1 vector */
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, InitSSActive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, InitSSInactive),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, InitSSInactive),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, Init),
+	ETPU_VECTOR1(6,     x,  x, x, x,  x, x, CountersSnapshot),
+	ETPU_VECTOR1(7,     x,  x, x, x,  x, x, SetData),
+	
+	/* Clock transition detected - each detected edge */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, ClockEdge_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, ClockEdge_LSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, ClockEdge_LSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, ClockEdge_LSB),
+
+	/* FLAG1 is not used by the EDGE tables */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, ClockEdge_LSB),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, ClockEdge_LSB),
+	/* prioritize edge over timeout */
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, ClockEdge_LSB),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, ClockEdge_LSB),
+	
+	/* Clock timeout detected */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, ClockTimeout),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, ClockTimeout),
+	
+	/* Select line transition detected */
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, SelectTransDetected),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, SelectTransDetected),
+	
+	/* Select line level check */
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, SelectLevelCheck),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, SelectLevelCheck),
+
+    /* invalid entries */	
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, ErrorHandler),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, ErrorHandler),
+};
+
+
+_eTPU_thread SPI_slave::Init(_eTPU_matches_disabled)
+{
+    if (_use_TCR1 == TRUE)
+    {
+        channel.TBSA = TBS_M1C1GE;
+    }
+    else
+    {
+        channel.TBSA = TBS_M2C2GE;
+    }
+
+    channel.PDCM = PDCM_SM_ST;
+    channel.TBSA = TBSA_CLR_OBE;
+    channel.IPACA = IPAC_EITHER;
+    if (_sample_edge == SPI_SLAVE_EDGE_RISING)
+    {
+        channel.IPACA = IPAC_RISING;
+    }
+    else if (_sample_edge == SPI_SLAVE_EDGE_FALLING)
+    {
+        channel.IPACA = IPAC_FALLING;
+    }
+    /* clear all latches */
+    channel.LSR = LSR_CLEAR;
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    channel.TDL = TDL_CLEAR;
+    channel.MTD = MTD_ENABLE;
+    /* set flag state, awaiting clock leading edge */
+    channel.FLAG0 = 0;
+    channel.FLAG1 = 0;
+    _bit_count_current = 0;
+    _crc_phase = SPI_SLAVE_CRC_PHASE_DATA;
+    _reg_write = 0;
+    _resync = 0;
+    
+    /* configure data channels */
+    chan += 1;
+    channel.TBSA = TBSA_CLR_OBE;
+   
+    chan -= 2;
+    /* MISO is driven on its match B by the EDGE tables */
+    channel.PDCM = PDCM_EM_NB_ST;
+    channel.MRLB = MRL_CLEAR;
+    if (_use_TCR1 == TRUE)
+    {
+        channel.TBSB = TBS_M1C1GE;
+    }
+    else
+    {
+        channel.TBSB = TBS_M2C2GE;
+    }
+    if (_selected_flag == 1)
+    {
+        channel.TBSA = TBSA_SET_OBE;
+    }
+    else
+    {
+        channel.TBSA = TBSA_CLR_OBE;
+    }
+}
+
+_eTPU_thread SPI_slave::InitSSActive(_eTPU_matches_disabled)
+{
+    _selected_flag = 1;
+    _ss_index = SelectIndex();
+    CommonInitSS();
+    
+}
+
+_eTPU_thread SPI_slave::InitSSInactive(_eTPU_matches_disabled)
+{
+    /* another device may already be active */
+    if (SelectIndex() == _ss_index)
+    {
+        _selected_flag = 0;
+    }
+    CommonInitSS();
+}
+
+_eTPU_fragment SPI_slave::CommonInitSS()
+{
+    channel.TBSA = TBSA_CLR_OBE;
+    channel.PDCM = PDCM_SM_ST;
+    if (_use_TCR1 == TRUE)
+    {
+        channel.TBSA = TBS_M1C1GE;
+    }
+    else
+    {
+        channel.TBSA = TBS_M2C2GE;
+    }
+    channel.FLAG0 = 1;
+    channel.IPACA = IPAC_EITHER; /* detect all transitions */
+    channel.LSR = LSR_CLEAR;
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    channel.TDL = TDL_CLEAR;
+    
+    /* optional pin level sanity polling */
+    if (_ss_poll_period != 0)
+    {
+        if (_use_TCR1 == TRUE)
+        {
+            erta = tcr1 + _ss_poll_period;
+        }
+        else
+        {
+            erta = tcr2 + _ss_poll_period;
+        }
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    }
+    channel.MTD = MTD_ENABLE;
+}
+
+
+/* Slave select channel threads */
+_eTPU_thread SPI_slave::SelectTransDetected(_eTPU_matches_enabled)
+{
+    int8_t ss_index;
+
+    channel.TDL = TDL_CLEAR;
+    ss_index = SelectIndex();
+    if (channel.PSTI == 0)
+    {
+        _selected_flag = 1;
+        _resync = 0;
+        _ss_index = ss_index;
+        if (_ss_cnt > 1)
+        {
+            _data_out_reg = _dev_buf[ss_index].data_out;
+        }
+        _bit_count_current = 0;
+        _crc_phase = SPI_SLAVE_CRC_PHASE_DATA;
+        _reg_write = 0;
+        if (_frame != 0)
+        {
+            _frame->word_cnt = 0;
+        }
+        else
+        {
+            /* frames only interrupt at their end */
+            channel.CIRC = CIRC_INT_FROM_SERVICED;
+        }
+        chan = _MISO_chan;
+        channel.TBSA = TBSA_SET_OBE;
+        /* need to put first output bit on pin depending upon clock phase */
+        if (channel.FM0 == 0)
+        {
+            WriteData();
+        }
+    }
+    else if (ss_index == _ss_index)
+    {
+        _selected_flag = 0;
+        _resync = 0;
+        if (_frame != 0)
+        {
+            FrameEnd();
+        }
+        else
+        {
+            if (_bit_count_current != 0)
+            {
+                SPI_SLAVE_COUNT(abort_cnt);
+            }
+            channel.CIRC = CIRC_INT_FROM_SERVICED;
+        }
+        chan = _MISO_chan;
+        channel.TBSA = TBSA_CLR_OBE;
+    }
+}
+
+_eTPU_thread SPI_slave::SelectLevelCheck(_eTPU_matches_enabled)
+{
+    int8_t ss_index;
+
+    /* continue polling */
+    erta += _ss_poll_period;
+    channel.MRLA = MRL_CLEAR;
+    channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    
+    ss_index = SelectIndex();
+    if (channel.PSTI == 0)
+    {
+        if ((_selected_flag == 0) && (_resync == 0))
+        {
+            _selected_flag = 1;
+            _resync = 0;
+            _ss_index = ss_index;
+            if (_ss_cnt > 1)
+            {
+                _data_out_reg = _dev_buf[ss_index].data_out;
+            }
+            _bit_count_current = 0;
+            _crc_phase = SPI_SLAVE_CRC_PHASE_DATA;
+            _reg_write = 0;
+            if (_frame != 0)
+            {
+                _frame->word_cnt = 0;
+            }
+            else
+            {
+                channel.CIRC = CIRC_INT_FROM_SERVICED;
+            }
+            chan = _MISO_chan;
+            channel.TBSA = TBSA_SET_OBE;
+            /* need to put first output bit on pin depending upon clock phase */
+            if (channel.FM0 == 0)
+            {
+                WriteData();
+            }
+        }
+    }
+    else
+    {
+        if (((_selected_flag == 1) || (_resync != 0)) && (ss_index == _ss_index))
+        {
+            _selected_flag = 0;
+            _resync = 0;
+            if (_frame != 0)
+            {
+                FrameEnd();
+            }
+            else
+            {
+                if (_bit_count_current != 0)
+                {
+                    SPI_SLAVE_COUNT(abort_cnt);
+                }
+                channel.CIRC = CIRC_INT_FROM_SERVICED;
+            }
+            chan = _MISO_chan;
+            channel.TBSA = TBSA_CLR_OBE;
+        }
+    }
+}
 
 /* SCLK channel threads */
 
-_eTPU_thread SPI_slave::SetData(_eTPU_matches_enabled)
+_eTPU_thread SPI_slave::CountersSnapshot(_eTPU_matches_enabled)
+{
+    SPI_slave_counters_t *counters = _counters;
+
+    /* copy and clear in one thread, so no count is lost or torn */
+    if (counters != 0)
+    {
+        counters->snap_rx_overrun_cnt = counters->rx_overrun_cnt;
+        counters->snap_tx_underrun_cnt = counters->tx_underrun_cnt;
+        counters->snap_timeout_cnt = counters->timeout_cnt;
+        counters->snap_abort_cnt = counters->abort_cnt;
+        counters->snap_error_cnt = counters->error_cnt;
+        counters->snap_glitch_cnt = counters->glitch_cnt;
+        counters->rx_overrun_cnt = 0;
+        counters->tx_underrun_cnt = 0;
+        counters->timeout_cnt = 0;
+        counters->abort_cnt = 0;
+        counters->error_cnt = 0;
+        counters->glitch_cnt = 0;
+    }
+}
+
+_eTPU_thread SPI_slave::ErrorHandler(_eTPU_matches_enabled)
+{
+    /* unexpected entry - count it, then clear the latches that caused it */
+    SPI_SLAVE_COUNT(error_cnt);
+    channel.LSR = LSR_CLEAR;
+    channel.MRLA = MRL_CLEAR;
+    channel.MRLB = MRL_CLEAR;
+    channel.TDL = TDL_CLEAR;
+}
+
+_eTPU_thread SPI_slave::SetData(_eTPU_matches_enabled)
+{
+    /* when there is no slave select, and CPHA is 0, need to put the first bit out
+       on pin BEFORE any clocking action */
+    if (_selected_flag == 1 && channel.FM0 == 0)
+    {
+        chan -= 1;
+        WriteData();
+    }
+}
+
+/* clock edge threads - one set per clock phase and shift direction, so no
+   mode tests are made per bit */
+
+_eTPU_thread SPI_slave::ClockLeading_CPHA0_LSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 1;
+    chan += 1;
+    ReadDataLSB();
+}
+
+_eTPU_thread SPI_slave::ClockLeading_CPHA0_MSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 1;
+    chan += 1;
+    ReadDataMSB();
+}
+
+_eTPU_thread SPI_slave::ClockLeading_CPHA1_LSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 1;
+    chan -= 1;
+    WriteDataLSB();
+}
+
+_eTPU_thread SPI_slave::ClockLeading_CPHA1_MSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 1;
+    chan -= 1;
+    WriteDataMSB();
+}
+
+_eTPU_thread SPI_slave::ClockTrailing_CPHA0_LSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 0;
+    chan -= 1;
+    WriteDataLSB();
+}
+
+_eTPU_thread SPI_slave::ClockTrailing_CPHA0_MSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 0;
+    chan -= 1;
+    WriteDataMSB();
+}
+
+_eTPU_thread SPI_slave::ClockTrailing_CPHA1_LSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 0;
+    chan += 1;
+    ReadDataLSB();
+}
+
+_eTPU_thread SPI_slave::ClockTrailing_CPHA1_MSB(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        /* ignore this, slave not selected */
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 0;
+    chan += 1;
+    ReadDataMSB();
+}
+
+_eTPU_thread SPI_slave::ClockLeading_CPHA0_CRC(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 1;
+    chan += 1;
+    ReadDataCRC();
+}
+
+_eTPU_thread SPI_slave::ClockLeading_CPHA1_CRC(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 1;
+    chan -= 1;
+    WriteDataCRC();
+}
+
+_eTPU_thread SPI_slave::ClockTrailing_CPHA0_CRC(_eTPU_matches_enabled)
+{
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
+    {
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    channel.FLAG1 = 0;
+    chan -= 1;
+    WriteDataCRC();
+}
+
+_eTPU_thread SPI_slave::ClockTrailing_CPHA1_CRC(_eTPU_matches_enabled)
 {
-    /* when there is no slave select, and CPHA is 0, need to put the first bit out
-       on pin BEFORE any clocking action */
-    if (_selected_flag == 1 && channel.FM0 == 0)
+    channel.TDL = TDL_CLEAR;
+    if (!_selected_flag)
     {
-        chan -= 1;
-        WriteData();
+        return;
+    }
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
     }
+    channel.FLAG1 = 0;
+    chan += 1;
+    ReadDataCRC();
 }
 
-_eTPU_thread SPI_slave::ClockLeading(_eTPU_matches_enabled)
+/* one bit per edge threads - a bit is read, and the next one scheduled out,
+   on every detected edge */
+
+_eTPU_thread SPI_slave::ClockEdge_LSB(_eTPU_matches_enabled)
 {
     channel.TDL = TDL_CLEAR;
     if (!_selected_flag)
@@ -317,21 +1290,50 @@ _eTPU_thread SPI_slave::ClockLeading(_eTPU_matches_enabled)
         /* ignore this, slave not selected */
         return;
     }
-    channel.FLAG1 = 1;
-    
-    if (channel.FM0 == 0)
+    if ((_edge != 0) && (EdgeCheck() != 0))
     {
-        chan += 1;
-        ReadData();
+        return;
     }
-    else
+    /* MISO changes a hold time after the captured edge */
+    ertb = erta + _miso_hold;
+
+    chan += 1;
+    _data_in_shift_reg >>= 1;
+    if (channel.PSTI == 1)
+        _data_in_shift_reg |= 0x800000;
+
+    chan -= 1;
+    if (_bit_count_current == 0)
     {
-        chan -= 1;
-        WriteData();
+        /* first bit - one timeout check covers the whole word */
+        erta += _timeout;
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+    }
+    if (++_bit_count_current == _bit_count)
+    {
+        /* this word is done, the next one follows without a gap */
+        _data_in_reg = _data_in_shift_reg;
+        WordStore();
+        _bit_count_current = 0;
+        _data_out_shift_reg = _data_out_reg;
+        if (_long != 0)
+        {
+            _data_out_shift_reg = _long->data_out_lead;
+        }
+        /* end timeout check */
+        channel.MRLE = MRLE_DISABLE;
+        RegisterWrite();
+    }
+    else if (_bit_count_current == _seg_bit_count)
+    {
+        SegmentBoundary();
     }
+    chan -= 1;
+    _data_out_shift_reg >>= 1;
+    WriteDataPinMatch();
 }
 
-_eTPU_thread SPI_slave::ClockTrailing(_eTPU_matches_enabled)
+_eTPU_thread SPI_slave::ClockEdge_MSB(_eTPU_matches_enabled)
 {
     channel.TDL = TDL_CLEAR;
     if (!_selected_flag)
@@ -339,86 +1341,232 @@ _eTPU_thread SPI_slave::ClockTrailing(_eTPU_matches_enabled)
         /* ignore this, slave not selected */
         return;
     }
-    channel.FLAG1 = 0;
+    if ((_edge != 0) && (EdgeCheck() != 0))
+    {
+        return;
+    }
+    /* MISO changes a hold time after the captured edge */
+    ertb = erta + _miso_hold;
+
+    chan += 1;
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
+        _data_in_shift_reg += 1;
 
-    if (channel.FM0 == 0)
+    chan -= 1;
+    if (_bit_count_current == 0)
     {
-        chan -= 1;
-        WriteData();
+        /* first bit - one timeout check covers the whole word */
+        erta += _timeout;
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
     }
-    else
+    if (++_bit_count_current == _bit_count)
+    {
+        /* this word is done, the next one follows without a gap */
+        _data_in_reg = _data_in_shift_reg;
+        WordStore();
+        _bit_count_current = 0;
+        _data_out_shift_reg = _data_out_reg;
+        if (_long != 0)
+        {
+            _data_out_shift_reg = _long->data_out_lead;
+        }
+        /* end timeout check */
+        channel.MRLE = MRLE_DISABLE;
+        RegisterWrite();
+    }
+    else if (_bit_count_current == _seg_bit_count)
     {
-        chan += 1;
-        ReadData();
+        SegmentBoundary();
     }
+    chan -= 1;
+    _data_out_shift_reg <<= 1;
+    WriteDataPinMatch();
 }
 
 _eTPU_thread SPI_slave::ClockTimeout(_eTPU_matches_enabled)
 {
     channel.MRLA = MRL_CLEAR;
+    SPI_SLAVE_COUNT(timeout_cnt);
     /* reset to awaiting new transmission */
     channel.FLAG1 = 0;
     _bit_count_current = 0;
+    _crc_phase = SPI_SLAVE_CRC_PHASE_DATA;
+    _reg_write = 0;
     chan -= 1;
     channel.TBSA = TBSA_CLR_OBE;
 }
 
 
-_eTPU_fragment SPI_slave::ReadData()
+_eTPU_fragment SPI_slave::ReadDataLSB()
 {
-    if (channel.FM1 == SPI_SLAVE_SHIFT_DIR_LSB_FM1)
+    _data_in_shift_reg >>= 1;
+    if (channel.PSTI == 1)
+        _data_in_shift_reg |= 0x800000;
+
+    ReadDataCount();
+}
+
+_eTPU_fragment SPI_slave::ReadDataMSB()
+{
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
+        _data_in_shift_reg += 1;
+
+    ReadDataCount();
+}
+
+_eTPU_fragment SPI_slave::ReadDataCRC()
+{
+    _data_in_shift_reg <<= 1;
+    if (channel.PSTI == 1)
     {
-        _data_in_shift_reg >>= 1;
-        if (channel.PSTI == 1)
-            _data_in_shift_reg |= 0x800000;
+        _data_in_shift_reg += 1;
+        _crc->in ^= 0x800000;
     }
-    else
+    CRCIn();
+
+    ReadDataCount();
+}
+
+_eTPU_fragment SPI_slave::ReadDataCount()
+{
+    /* back on the SCLK channel */
+    chan -= 1;
+    if ((_bit_count_current == 0) && (_crc_phase == SPI_SLAVE_CRC_PHASE_DATA))
     {
-        _data_in_shift_reg <<= 1;
-        if (channel.PSTI == 1)
-            _data_in_shift_reg += 1;
+        /* first bit - one timeout check covers the whole word and its CRC */
+        erta += _timeout;
+        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
     }
-
     if (++_bit_count_current == _bit_count)
     {
+        if (_crc != 0)
+        {
+            SPI_slave_crc_t *crc = _crc;
+
+            if (_crc_phase == SPI_SLAVE_CRC_PHASE_DATA)
+            {
+                /* data bits are done, CRC bits follow - count them up to _bit_count */
+                _data_in_reg = _data_in_shift_reg;
+                _crc_phase = SPI_SLAVE_CRC_PHASE_CRC;
+                _data_out_shift_reg = crc->out ^ crc->xorout;
+                _bit_count_current = _bit_count - crc->bit_count;
+                return;
+            }
+            _crc_phase = SPI_SLAVE_CRC_PHASE_DATA;
+            /* a mismatch is sticky until read, the host finds it at the
+               channel interrupt that ends the word or frame */
+            if (crc->in != crc->residue)
+            {
+                crc->error = 1;
+            }
+        }
+        else
+        {
+            _data_in_reg = _data_in_shift_reg;
+        }
         /* this word is done */
-        _data_in_reg = _data_in_shift_reg;
-        channel.CIRC = CIRC_INT_FROM_SERVICED;
+        WordStore();
         /* prepare for next word */
         _bit_count_current = 0;
         /* end timeout check */
         channel.MRLE = MRLE_DISABLE;
+        RegisterWrite();
     }
-    else
+    else if (_bit_count_current == _seg_bit_count)
     {
-        /* set up timeout check */
-        chan -= 1;
-        channel.MRLE = MRLE_DISABLE;
-        erta += _timeout;
-        channel.ERWA = ERW_WRITE_ERT_TO_MATCH;
+        SegmentBoundary();
     }
 }
 
 _eTPU_fragment SPI_slave::WriteData()
 {
-    /* note that if CPHA == 0, this is entered at the end of the LAST clock, but
-       sampling the data out register and outputing a bit is a don't care, so
-       to streamline code, just let it happen */
+    /* first bit of a word, outside the clock edge threads */
+    if (channel.FM1 == SPI_SLAVE_SHIFT_DIR_LSB_FM1)
+    {
+        WriteDataLSB();
+    }
+    else if (_crc != 0)
+    {
+        WriteDataCRC();
+    }
+    else
+    {
+        WriteDataMSB();
+    }
+}
+
+/* note that if CPHA == 0, WriteData is entered at the end of the LAST clock, but
+   sampling the data out register and outputing a bit is a don't care, so
+   to streamline code, just let it happen */
 
+_eTPU_fragment SPI_slave::WriteDataLSB()
+{
     if (_bit_count_current == 0)
     {
-        /* sample data out register into data out shift register */
-        _data_out_shift_reg = _data_out_reg;
+        if (_crc_phase == SPI_SLAVE_CRC_PHASE_DATA)
+        {
+            /* sample data out register into data out shift register */
+            _data_out_shift_reg = _data_out_reg;
+            if (_long != 0)
+            {
+                _data_out_shift_reg = _long->data_out_lead;
+            }
+        }
     } 
 
-    if (channel.FM1 == SPI_SLAVE_SHIFT_DIR_LSB_FM1)
+    _data_out_shift_reg >>= 1;
+    WriteDataPin();
+}
+
+_eTPU_fragment SPI_slave::WriteDataMSB()
+{
+    if (_bit_count_current == 0)
+    {
+        if (_crc_phase == SPI_SLAVE_CRC_PHASE_DATA)
+        {
+            /* sample data out register into data out shift register */
+            _data_out_shift_reg = _data_out_reg;
+            if (_long != 0)
+            {
+                _data_out_shift_reg = _long->data_out_lead;
+            }
+        }
+    } 
+
+    _data_out_shift_reg <<= 1;
+    WriteDataPin();
+}
+
+_eTPU_fragment SPI_slave::WriteDataCRC()
+{
+    if (_bit_count_current == 0)
+    {
+        if (_crc_phase == SPI_SLAVE_CRC_PHASE_DATA)
+        {
+            /* words of up to 24 bits only with CRC */
+            _data_out_shift_reg = _data_out_reg;
+            _crc->out = _crc->init;
+            _crc->in = _crc->init;
+        }
+    }
+
+    _data_out_shift_reg <<= 1;
+    if (CC.C == 1)
     {
-        _data_out_shift_reg >>= 1;
+        channel.PIN = PIN_SET_HIGH;
+        _crc->out ^= 0x800000;
     }
     else
     {
-        _data_out_shift_reg <<= 1;
+        channel.PIN = PIN_SET_LOW;
     }
+    CRCOut();
+}
+
+_eTPU_fragment SPI_slave::WriteDataPin()
+{
     if (CC.C == 1)
     {
         channel.PIN = PIN_SET_HIGH;
@@ -429,11 +1577,245 @@ _eTPU_fragment SPI_slave::WriteData()
     }
 }
 
+_eTPU_fragment SPI_slave::WriteDataPinMatch()
+{
+    /* on the MISO channel - CC.C is the next bit, driven at ertb by match B */
+    if (CC.C == 1)
+    {
+        channel.OPACB = OPAC_MATCH_HIGH;
+    }
+    else
+    {
+        channel.OPACB = OPAC_MATCH_LOW;
+    }
+    channel.MRLB = MRL_CLEAR;
+    channel.ERWB = ERW_WRITE_ERT_TO_MATCH;
+}
+
+void SPI_slave::RegisterCommand()
+{
+    SPI_slave_reg_t *reg = _reg;
+
+    /* the command is in the low bits of the data in shift register, the
+       addressed register goes out as the rest of this word */
+    reg->addr = _data_in_shift_reg & reg->addr_mask;
+    _reg_write = 0;
+    if ((_data_in_shift_reg & reg->write_flag) != 0)
+    {
+        _reg_write = 1;
+    }
+    _data_out_shift_reg = reg->table[reg->addr];
+}
+
+void SPI_slave::RegisterWrite()
+{
+    if (_reg_write != 0)
+    {
+        /* the multiply left-justifies the data bits, dropping the command */
+        _reg->table[_reg->addr] = _data_in_shift_reg * _reg->align;
+        _reg_write = 0;
+    }
+}
+
+void SPI_slave::WordStore()
+{
+    if (_long != 0)
+    {
+        _long->data_in_lead = _long->data_in_seg;
+    }
+    _data_in_index = _ss_index;
+    if (_ss_cnt > 1)
+    {
+        /* virtual device - the next word out is reloaded after this */
+        _dev_buf[_ss_index].data_in = _data_in_shift_reg;
+        _data_out_reg = _dev_buf[_ss_index].data_out;
+    }
+    if (_frame == 0)
+    {
+        /* a word at a time - it went out as written by the host, or again;
+           register maps and virtual devices send their tables, not the word */
+        if ((_tx_fresh == 0) && (_reg == 0) && (_ss_cnt <= 1))
+        {
+            SPI_SLAVE_COUNT(tx_underrun_cnt);
+        }
+        _tx_fresh = 0;
+        if (_rx_full != 0)
+        {
+            SPI_SLAVE_COUNT(rx_overrun_cnt);
+        }
+        _rx_full = 1;
+        channel.CIRC = CIRC_INT_FROM_SERVICED;
+    }
+    else
+    {
+        SPI_slave_frame_t *frame = _frame;
+
+        if (frame->word_cnt < frame->word_max)
+        {
+            frame->buf[frame->word_cnt] = _data_in_shift_reg;
+        }
+        else
+        {
+            /* no room, the word is lost */
+            SPI_SLAVE_COUNT(rx_overrun_cnt);
+        }
+        frame->word_cnt++;
+    }
+}
+
+void SPI_slave::SegmentBoundary()
+{
+    /* register command in, or leading segment of a long word done - keep
+       it, the last 24 bits follow */
+    if (_reg != 0)
+    {
+        RegisterCommand();
+    }
+    else
+    {
+        _long->data_in_seg = _data_in_shift_reg;
+        _data_out_shift_reg = _data_out_reg;
+    }
+}
+
+void SPI_slave::CRCOut()
+{
+    /* one CRC step, the data bit already added into the top bit */
+    if ((_crc->out & 0x800000) != 0)
+    {
+        _crc->out = (_crc->out << 1) ^ _crc->poly;
+    }
+    else
+    {
+        _crc->out <<= 1;
+    }
+}
+
+void SPI_slave::CRCIn()
+{
+    if ((_crc->in & 0x800000) != 0)
+    {
+        _crc->in = (_crc->in << 1) ^ _crc->poly;
+    }
+    else
+    {
+        _crc->in <<= 1;
+    }
+}
+
+int8_t SPI_slave::EdgeCheck()
+{
+    SPI_slave_edge_t *edge = _edge;
+    uint24_t spacing;
+    int24_t diff;
+
+    /* on the SCLK channel - erta is this edge */
+    spacing = erta - edge->last_edge;
+    edge->last_edge = erta;
+    if (_bit_count_current == 0)
+    {
+        /* the last edge was in an earlier word */
+        return 0;
+    }
+    if ((edge->min_spacing != 0) && (spacing < edge->min_spacing))
+    {
+        /* too close to the last edge - drop the word (frame) */
+        SPI_SLAVE_COUNT(glitch_cnt);
+        channel.FLAG1 = 0;
+        channel.MRLE = MRLE_DISABLE;
+        _bit_count_current = 0;
+        _crc_phase = SPI_SLAVE_CRC_PHASE_DATA;
+        _reg_write = 0;
+        if (_frame != 0)
+        {
+            _frame->word_cnt = 0;
+        }
+        if (_ss_cnt != 0)
+        {
+            /* ignore the rest of this select */
+            _selected_flag = 0;
+            _resync = 1;
+            chan = _MISO_chan;
+            channel.TBSA = TBSA_CLR_OBE;
+            chan += 1;
+        }
+        return 1;
+    }
+    /* in spec - edge statistics, if enabled */
+    if (edge->stats == 0)
+    {
+        return 0;
+    }
+    if (edge->restart != 0)
+    {
+        edge->restart = 0;
+        edge->min = spacing;
+        edge->max = spacing;
+        edge->avg = spacing;
+    }
+    if (spacing < edge->min)
+    {
+        edge->min = spacing;
+    }
+    if (spacing > edge->max)
+    {
+        edge->max = spacing;
+    }
+    diff = spacing - edge->avg;
+    edge->avg += diff >> 3;
+    return 0;
+}
+
+int8_t SPI_slave::SelectIndex()
+{
+    int8_t i;
+    uint24_t ss_chan_pack = _ss_chan_pack;
+
+    /* on an SS channel - find its device */
+    for (i = 0; i < SPI_SLAVE_MAX_SS_CNT - 1; i++)
+    {
+        if ((ss_chan_pack & SPI_SLAVE_SS_CHAN_MASK) == chan)
+        {
+            break;
+        }
+        ss_chan_pack >>= SPI_SLAVE_SS_CHAN_BITS;
+    }
+    return i;
+}
+
+void SPI_slave::FrameEnd()
+{
+    /* on the SS channel - the exact length, a trailing part word is stored
+       as received */
+    SPI_slave_frame_t *frame = _frame;
+
+    frame->bit_cnt = frame->word_cnt * _bit_count + _bit_count_current;
+    if ((_bit_count_current != 0) && (frame->word_cnt < frame->word_max))
+    {
+        frame->buf[frame->word_cnt] = _data_in_shift_reg;
+    }
+    _bit_count_current = 0;
+    if (_rx_full != 0)
+    {
+        SPI_SLAVE_COUNT(rx_overrun_cnt);
+    }
+    _rx_full = 1;
+    channel.CIRC = CIRC_INT_FROM_SERVICED;
+    /* end the timeout check of a part word, await a leading edge */
+    chan = _MISO_chan + 1;
+    channel.MRLE = MRLE_DISABLE;
+    channel.FLAG1 = 0;
+}
+
 
 #pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_INIT_HSR", SPI_SLAVE_INIT_HSR
 #pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_INIT_SS_HSR", SPI_SLAVE_INIT_SS_HSR
 #pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_SET_DATA_HSR", SPI_SLAVE_SET_DATA_HSR
+#pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_COUNTERS_HSR", SPI_SLAVE_COUNTERS_HSR
 #pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_CPHA_0_FM0", SPI_SLAVE_CPHA_0_FM0
 #pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_CPHA_1_FM0", SPI_SLAVE_CPHA_1_FM0
 #pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_SHIFT_DIR_MSB_FM1", SPI_SLAVE_SHIFT_DIR_MSB_FM1
 #pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_SHIFT_DIR_LSB_FM1", SPI_SLAVE_SHIFT_DIR_LSB_FM1
+#pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_EDGE_BOTH", SPI_SLAVE_EDGE_BOTH
+#pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_EDGE_RISING", SPI_SLAVE_EDGE_RISING
+#pragma export_autodef_macro "FS_ETPU_SPI_SLAVE_EDGE_FALLING", SPI_SLAVE_EDGE_FALLING
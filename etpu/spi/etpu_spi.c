@@ -8,6 +8,610 @@
 #include "etpu_auto_api.h"      /* auto-generated eTPU interface data */
 #include "etpu_spi.h"           /* eTPU SPI API header */
 
+/* eTPU DATA RAM layout of a SPI_master angle schedule entry (must match
+   SPI_master_angle_entry_t in etec_spi_master.c), accessed via PSE mirror */
+struct spi_master_angle_entry_pse_t
+{
+    uint32_t      angle;
+    uint32_t      slave_select_chan;
+    uint32_t      slave_select_addr;
+    uint32_t      data_out;
+    uint32_t      data_in;
+};
+
+/* eTPU DATA RAM layout of a SPI_master daisy chain entry (must match
+   SPI_master_chain_entry_t in etec_spi_master.c), accessed via PSE mirror */
+struct spi_master_chain_entry_pse_t
+{
+    uint32_t      data_out;
+    uint32_t      data_in;
+};
+
+/* eTPU DATA RAM layout of the SPI_master optional state blocks (must match
+   SPI_master_x_t in etec_spi_master.c), accessed via PSE mirror - the
+   trailing array of a block is sized when it is allocated */
+struct spi_master_crc_pse_t
+{
+    uint32_t      poly;
+    uint32_t      init;
+    uint32_t      xorout;
+    uint32_t      residue;
+    uint32_t      bit_count;
+    uint32_t      error;
+    uint32_t      out;
+    uint32_t      in;
+    uint32_t      phase;
+};
+
+struct spi_master_xfer_pse_t
+{
+    uint32_t      cnt;
+    uint32_t      index;
+    uint32_t      run;
+};
+
+struct spi_master_burst_pse_t
+{
+    struct spi_master_xfer_pse_t xfer;
+    uint32_t      dummy;
+    uint32_t      cmd_bit_count;
+    uint32_t      rx_buf[1];
+};
+
+struct spi_master_chain_pse_t
+{
+    struct spi_master_xfer_pse_t xfer;
+    uint32_t      refresh_period;
+    uint32_t      latch_width;
+    uint32_t      start_time;
+    uint32_t      latch_chan;
+    uint32_t      latch_polarity;
+    struct spi_master_chain_entry_pse_t entry[1];
+};
+
+struct spi_master_stream_pse_t
+{
+    struct spi_master_xfer_pse_t xfer;
+    uint32_t      frame_cnt;
+    uint32_t      frame_index;
+    uint32_t      buf[1];
+};
+
+struct spi_master_counters_pse_t
+{
+    uint32_t      rx_overrun_cnt;
+    uint32_t      tx_underrun_cnt;
+    uint32_t      error_cnt;
+    uint32_t      snap_rx_overrun_cnt;
+    uint32_t      snap_tx_underrun_cnt;
+    uint32_t      snap_error_cnt;
+};
+
+/* eTPU DATA RAM layout of a SPI_slave virtual device entry (must match
+   SPI_slave_dev_entry_t in etec_spi_slave.c), accessed via PSE mirror */
+struct spi_slave_dev_entry_pse_t
+{
+    uint32_t      data_out;
+    uint32_t      data_in;
+};
+
+/* eTPU DATA RAM layout of the SPI_slave optional state blocks (must match
+   SPI_slave_x_t in etec_spi_slave.c), accessed via PSE mirror */
+struct spi_slave_crc_pse_t
+{
+    uint32_t      poly;
+    uint32_t      init;
+    uint32_t      xorout;
+    uint32_t      residue;
+    uint32_t      bit_count;
+    uint32_t      error;
+    uint32_t      out;
+    uint32_t      in;
+};
+
+struct spi_slave_reg_pse_t
+{
+    uint32_t      addr_mask;
+    uint32_t      write_flag;
+    uint32_t      align;
+    uint32_t      addr;
+    uint32_t      table[1];
+};
+
+struct spi_slave_frame_pse_t
+{
+    uint32_t      word_max;
+    uint32_t      word_cnt;
+    uint32_t      bit_cnt;
+    uint32_t      buf[1];
+};
+
+struct spi_slave_long_pse_t
+{
+    uint32_t      data_out_lead;
+    uint32_t      data_in_lead;
+    uint32_t      data_in_seg;
+};
+
+struct spi_slave_edge_pse_t
+{
+    uint32_t      min_spacing;
+    uint32_t      last_edge;
+    uint32_t      stats;
+    uint32_t      restart;
+    uint32_t      min;
+    uint32_t      max;
+    uint32_t      avg;
+};
+
+struct spi_slave_counters_pse_t
+{
+    uint32_t      rx_overrun_cnt;
+    uint32_t      tx_underrun_cnt;
+    uint32_t      timeout_cnt;
+    uint32_t      abort_cnt;
+    uint32_t      error_cnt;
+    uint32_t      glitch_cnt;
+    uint32_t      snap_rx_overrun_cnt;
+    uint32_t      snap_tx_underrun_cnt;
+    uint32_t      snap_timeout_cnt;
+    uint32_t      snap_abort_cnt;
+    uint32_t      snap_error_cnt;
+    uint32_t      snap_glitch_cnt;
+};
+
+/* bytes of a block with cnt entries in its trailing array */
+#define FS_ETPU_SPI_BLOCK_SIZE(block, entry, cnt) (sizeof(block) - sizeof(entry) + (cnt) * sizeof(entry))
+
+/* host reads of a pending HSR before giving up - far longer than the eTPU
+   needs to service one, a stopped engine makes the wait fail */
+#define FS_ETPU_SPI_HSR_WAIT_CNT  100000
+
+/* CRC registers are held left-justified in 24 bits by the eTPU */
+#define FS_ETPU_SPI_CRC_ALIGN(value, crc_size) (((value) << (24 - (crc_size))) & 0xffffff)
+
+/* the host-only frame word _attach_sum holds the attach checksum of its
+   instance - channel binding, buffer sizes and buffer addresses - so the
+   instance can be re-attached to the running frame after a host reset */
+#define FS_ETPU_SPI_ATTACH_MAGIC_MASTER 0x53504d31 /* "SPM1" */
+#define FS_ETPU_SPI_ATTACH_MAGIC_SLAVE  0x53505331 /* "SPS1" */
+/* CR as init leaves it - interrupt and DMA enables may change later */
+#define FS_ETPU_SPI_ATTACH_CR_MASK      0x3fffffff
+
+/* the residue is what the CRC register holds after a word and its correct CRC
+   (CRC ^ xorout) have been run through it - the CRC of xorout from 0 */
+static uint32_t fs_etpu_spi_crc_residue(
+    uint8_t crc_size,
+    uint32_t crc_polynomial,
+    uint32_t crc_xorout)
+{
+    uint32_t poly = FS_ETPU_SPI_CRC_ALIGN(crc_polynomial, crc_size);
+    uint32_t xorout = FS_ETPU_SPI_CRC_ALIGN(crc_xorout, crc_size);
+    uint32_t crc = 0;
+    uint32_t i;
+
+    for (i = 0; i < crc_size; i++)
+    {
+        crc ^= (xorout << i) & 0x800000;
+        crc <<= 1;
+        if (crc & 0x1000000)
+        {
+            crc ^= poly;
+        }
+        crc &= 0xffffff;
+    }
+    return crc;
+}
+
+/* convert microseconds to timer counts carefully to avoid numerical overflow
+   and avoid floating point use */
+static uint32_t fs_etpu_spi_us_to_ticks(
+    uint32_t timer_freq,
+    uint32_t time_us)
+{
+    uint32_t timer_freq_mhz, timer_freq_khz, timer_freq_remainder, calc_temp;
+
+    timer_freq_mhz = timer_freq / 1000000;
+    timer_freq_remainder = timer_freq - (timer_freq_mhz * 1000000);
+    calc_temp = timer_freq_mhz * time_us;
+    timer_freq_khz = timer_freq_remainder / 1000;
+    timer_freq_remainder = timer_freq_remainder - (timer_freq_khz * 1000);
+    calc_temp += (timer_freq_khz * time_us) / 1000;
+    calc_temp += (timer_freq_remainder * time_us) / 1000000;
+    return calc_temp;
+}
+
+/* release DATA RAM held by an instance through its PSE pointer, of the size
+   recorded when it was allocated - the first error is kept */
+static void fs_etpu_spi_free_pse(
+    ETPU_MODULE em,
+    void **p_pse,
+    uint16_t *p_num_bytes,
+    uint32_t *p_err_code)
+{
+    uint32_t err_code;
+
+    if (*p_pse != 0)
+    {
+        err_code = fs_etpu_free_ext(em,
+            (uint32_t*)((uint32_t)*p_pse - (fs_etpu_data_ram_ext - fs_etpu_data_ram_start)), *p_num_bytes);
+        if (*p_err_code == 0)
+        {
+            *p_err_code = err_code;
+        }
+        *p_pse = 0;
+    }
+    *p_num_bytes = 0;
+}
+
+/* get num_bytes of DATA RAM for an instance buffer, held through its PSE
+   pointer with the size - a re-init keeps a block of the same size, a block
+   of another size is released first and num_bytes 0 just releases it; a new
+   block is cleared */
+static uint32_t fs_etpu_spi_alloc_pse(
+    ETPU_MODULE em,
+    void **p_pse,
+    uint16_t *p_num_bytes,
+    uint16_t num_bytes)
+{
+    uint32_t *p_mem;
+    uint32_t err_code = 0;
+
+    if (*p_num_bytes != num_bytes)
+    {
+        fs_etpu_spi_free_pse(em, p_pse, p_num_bytes, &err_code);
+        if (err_code != 0)
+        {
+            return err_code;
+        }
+    }
+    if ((*p_pse == 0) && (num_bytes != 0))
+    {
+        p_mem = fs_etpu_malloc_ext(em, num_bytes);
+        if (p_mem == 0)
+        {
+            return (FS_ETPU_ERROR_MALLOC);
+        }
+        fs_memset32_ext(p_mem, 0, num_bytes);
+        *p_pse = (void*)((uint32_t)p_mem + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+        *p_num_bytes = num_bytes;
+    }
+    return 0;
+}
+
+/* eTPU address of a buffer, 0 -> none */
+static uint32_t fs_etpu_spi_pse_addr(
+    void *p_pse)
+{
+    return (p_pse == 0) ? 0 : ((uint32_t)p_pse - fs_etpu_data_ram_ext);
+}
+
+/* buffer at a frame's eTPU address field, if the instance has one */
+static void *fs_etpu_spi_addr_pse(
+    uint32_t addr,
+    uint32_t used)
+{
+    return (used == 0) ? 0 : (void*)(fs_etpu_data_ram_ext + (addr & 0xffffff));
+}
+
+/* wait for the eTPU to service an HSR, at most FS_ETPU_SPI_HSR_WAIT_CNT reads */
+static uint32_t fs_etpu_spi_wait_hsr(
+    ETPU_MODULE em,
+    uint8_t chan_num)
+{
+    uint32_t i;
+
+    for (i = 0; i < FS_ETPU_SPI_HSR_WAIT_CNT; i++)
+    {
+        if (fs_etpu_get_hsr_ext(em, chan_num) == 0)
+        {
+            return 0;
+        }
+    }
+    return (FS_ETPU_ERROR_TIMING);
+}
+
+/* re-attach - take a buffer back from the allocator, keeping the first error */
+static void fs_etpu_spi_claim_pse(
+    ETPU_MODULE em,
+    void *p_pse,
+    uint16_t num_bytes,
+    uint32_t *p_err_code)
+{
+    uint32_t err_code;
+
+    if (p_pse != 0)
+    {
+        err_code = fs_etpu_claim_ext(em,
+            (uint32_t*)((uint32_t)p_pse - (fs_etpu_data_ram_ext - fs_etpu_data_ram_start)), num_bytes);
+        if (*p_err_code == 0)
+        {
+            *p_err_code = err_code;
+        }
+    }
+}
+
+/* each clock phase / shift direction combination has its own entry table
+   (eTPU function) with specialized clock edge threads - these return the
+   entry table type and function number fields of the channel CR */
+static uint32_t fs_etpu_spi_master_function(
+    struct spi_master_config_t *p_spi_master_config)
+{
+    if (p_spi_master_config->ddr != 0)
+    {
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            return (_ENTRY_TABLE_TYPE_SPI_master_DDR_LSB_ << 24) + (_FUNCTION_NUM_SPI_master_DDR_LSB_ << 16);
+        }
+        return (_ENTRY_TABLE_TYPE_SPI_master_DDR_MSB_ << 24) + (_FUNCTION_NUM_SPI_master_DDR_MSB_ << 16);
+    }
+    /* the CRC (MSB first only) and MISO sample delay have their own tables,
+       so the clock edge threads do not test for them */
+    if (p_spi_master_config->crc_size != 0)
+    {
+        if (p_spi_master_config->clock_phase == 1)
+        {
+            if (p_spi_master_config->miso_sample_delay_ticks != 0)
+            {
+                return (_ENTRY_TABLE_TYPE_SPI_master_CPHA1_CRC_DLY_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA1_CRC_DLY_ << 16);
+            }
+            return (_ENTRY_TABLE_TYPE_SPI_master_CPHA1_CRC_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA1_CRC_ << 16);
+        }
+        if (p_spi_master_config->miso_sample_delay_ticks != 0)
+        {
+            return (_ENTRY_TABLE_TYPE_SPI_master_CPHA0_CRC_DLY_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA0_CRC_DLY_ << 16);
+        }
+        return (_ENTRY_TABLE_TYPE_SPI_master_CPHA0_CRC_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA0_CRC_ << 16);
+    }
+    if (p_spi_master_config->miso_sample_delay_ticks != 0)
+    {
+        if (p_spi_master_config->clock_phase == 1)
+        {
+            if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+            {
+                return (_ENTRY_TABLE_TYPE_SPI_master_CPHA1_LSB_DLY_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA1_LSB_DLY_ << 16);
+            }
+            return (_ENTRY_TABLE_TYPE_SPI_master_CPHA1_MSB_DLY_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA1_MSB_DLY_ << 16);
+        }
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            return (_ENTRY_TABLE_TYPE_SPI_master_CPHA0_LSB_DLY_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA0_LSB_DLY_ << 16);
+        }
+        return (_ENTRY_TABLE_TYPE_SPI_master_CPHA0_MSB_DLY_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA0_MSB_DLY_ << 16);
+    }
+    if (p_spi_master_config->clock_phase == 1)
+    {
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            return (_ENTRY_TABLE_TYPE_SPI_master_CPHA1_LSB_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA1_LSB_ << 16);
+        }
+        return (_ENTRY_TABLE_TYPE_SPI_master_CPHA1_MSB_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA1_MSB_ << 16);
+    }
+    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+    {
+        return (_ENTRY_TABLE_TYPE_SPI_master_CPHA0_LSB_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA0_LSB_ << 16);
+    }
+    return (_ENTRY_TABLE_TYPE_SPI_master_CPHA0_MSB_ << 24) + (_FUNCTION_NUM_SPI_master_CPHA0_MSB_ << 16);
+}
+
+static uint32_t fs_etpu_spi_slave_function(
+    struct spi_slave_config_t *p_spi_slave_config)
+{
+    if ((p_spi_slave_config->ddr != 0) || (p_spi_slave_config->single_edge != 0))
+    {
+        if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            return (_ENTRY_TABLE_TYPE_SPI_slave_EDGE_LSB_ << 24) + (_FUNCTION_NUM_SPI_slave_EDGE_LSB_ << 16);
+        }
+        return (_ENTRY_TABLE_TYPE_SPI_slave_EDGE_MSB_ << 24) + (_FUNCTION_NUM_SPI_slave_EDGE_MSB_ << 16);
+    }
+    /* CRC (MSB first only) steps are made by the CRC table threads */
+    if (p_spi_slave_config->crc_size != 0)
+    {
+        if (p_spi_slave_config->clock_phase == 1)
+        {
+            return (_ENTRY_TABLE_TYPE_SPI_slave_CPHA1_CRC_ << 24) + (_FUNCTION_NUM_SPI_slave_CPHA1_CRC_ << 16);
+        }
+        return (_ENTRY_TABLE_TYPE_SPI_slave_CPHA0_CRC_ << 24) + (_FUNCTION_NUM_SPI_slave_CPHA0_CRC_ << 16);
+    }
+    if (p_spi_slave_config->clock_phase == 1)
+    {
+        if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            return (_ENTRY_TABLE_TYPE_SPI_slave_CPHA1_LSB_ << 24) + (_FUNCTION_NUM_SPI_slave_CPHA1_LSB_ << 16);
+        }
+        return (_ENTRY_TABLE_TYPE_SPI_slave_CPHA1_MSB_ << 24) + (_FUNCTION_NUM_SPI_slave_CPHA1_MSB_ << 16);
+    }
+    if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+    {
+        return (_ENTRY_TABLE_TYPE_SPI_slave_CPHA0_LSB_ << 24) + (_FUNCTION_NUM_SPI_slave_CPHA0_LSB_ << 16);
+    }
+    return (_ENTRY_TABLE_TYPE_SPI_slave_CPHA0_MSB_ << 24) + (_FUNCTION_NUM_SPI_slave_CPHA0_MSB_ << 16);
+}
+
+/* resolve a slave select index to the channel to assert and, in decoder mode,
+   the address to drive onto the decoder inputs */
+static uint32_t fs_etpu_spi_master_slave_select(
+    struct spi_master_instance_t *p_spi_master_instance,
+    int8_t slave_select_index,
+    uint32_t *p_chan,
+    uint32_t *p_addr)
+{
+    *p_addr = 0;
+    if (slave_select_index == -1)
+    {
+        *p_chan = 0xff;
+    }
+    else if (p_spi_master_instance->ss_decoder_addr_bit_cnt != 0)
+    {
+        if (slave_select_index >= (1 << p_spi_master_instance->ss_decoder_addr_bit_cnt))
+        {
+            return (FS_ETPU_ERROR_VALUE);
+        }
+        *p_chan = p_spi_master_instance->slave_select_chan_list[0];
+        *p_addr = slave_select_index;
+    }
+    else
+    {
+        if (slave_select_index >= FS_ETPU_SPI_MASTER_MAX_SLAVE_SELECT_CNT)
+        {
+            return (FS_ETPU_ERROR_VALUE);
+        }
+        *p_chan = p_spi_master_instance->slave_select_chan_list[slave_select_index];
+    }
+    return 0;
+}
+
+
+/* attach checksum of a master instance, from its channels and buffers */
+static uint32_t fs_etpu_spi_master_attach_sum(
+    struct spi_master_instance_t *p_spi_master_instance)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t words[12];
+    int32_t i;
+
+    if (p_spi_master_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    words[0] = FS_ETPU_SPI_ATTACH_MAGIC_MASTER;
+    for (i = -1; i <= 1; i++)
+    {
+        words[2 + i] = eTPU->CHAN[p_spi_master_instance->clock_chan_num + i].CR.R & FS_ETPU_SPI_ATTACH_CR_MASK;
+    }
+    words[4] = p_spi_master_instance->angle_entry_cnt | (p_spi_master_instance->burst_word_cnt_max << 8) |
+        (p_spi_master_instance->chain_word_cnt_max << 16);
+    words[5] = p_spi_master_instance->stream_word_cnt;
+    words[6] = fs_etpu_spi_pse_addr(p_spi_master_instance->angle_table_pse);
+    words[7] = fs_etpu_spi_pse_addr(p_spi_master_instance->burst_buffer_pse);
+    words[8] = fs_etpu_spi_pse_addr(p_spi_master_instance->chain_buffer_pse);
+    words[9] = fs_etpu_spi_pse_addr(p_spi_master_instance->stream_buffer_pse);
+    words[10] = fs_etpu_spi_pse_addr(p_spi_master_instance->crc_pse);
+    words[11] = fs_etpu_spi_pse_addr(p_spi_master_instance->counters_pse);
+
+    /* folded to the 24 bits of the frame word */
+    return fs_etpu_checksum_ext(words, sizeof(words)) & 0xffffff;
+}
+
+/* master configuration checks - all made before init stops a channel or
+   takes any DATA RAM, so a rejected configuration leaves a running
+   instance as it was */
+static uint32_t fs_etpu_spi_master_check(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t timer_freq)
+{
+    uint32_t ss_chan, ss_addr;
+    int32_t i;
+
+    if (p_spi_master_config->baud_rate_hz == 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* a delayed MISO sample must land before the next clock edge */
+    if (p_spi_master_config->miso_sample_delay_ticks >= timer_freq / (p_spi_master_config->baud_rate_hz * 2))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* DDR - the clock must end at its idle level, and each edge thread only
+       shifts data */
+    if ((p_spi_master_config->ddr != 0) &&
+        (((p_spi_master_config->transfer_size & 1) != 0) ||
+         (p_spi_master_config->crc_size != 0) ||
+         (p_spi_master_config->miso_sample_delay_ticks != 0)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* the decoder enable is the slave select output */
+    if ((p_spi_master_instance->ss_decoder_addr_bit_cnt != 0) &&
+        ((p_spi_master_instance->ss_decoder_addr_bit_cnt > FS_ETPU_SPI_MASTER_MAX_SS_DECODER_ADDR_BIT_CNT) ||
+         (p_spi_master_instance->slave_select_chan_list[0] == 0xff)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* CRC - MSB first, in 24 bits */
+    if ((p_spi_master_config->crc_size != 0) &&
+        ((p_spi_master_config->shift_direction != FS_ETPU_SPI_MSB_FIRST) ||
+         (p_spi_master_config->crc_size > 24)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    if (p_spi_master_instance->angle_entry_cnt != 0)
+    {
+        /* transfers are triggered from TCR2 angle, the clock must be timed on TCR1 */
+        if (p_spi_master_config->timer != FS_ETPU_TCR1)
+        {
+            return (FS_ETPU_ERROR_VALUE);
+        }
+        for (i = 0; i < p_spi_master_instance->angle_entry_cnt; i++)
+        {
+            if (fs_etpu_spi_master_slave_select(p_spi_master_instance,
+                p_spi_master_instance->angle_table[i].slave_select_index, &ss_chan, &ss_addr))
+            {
+                return (FS_ETPU_ERROR_VALUE);
+            }
+        }
+    }
+    /* the stream ring is refilled by halves */
+    if ((p_spi_master_instance->stream_word_cnt & 1) != 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    return 0;
+}
+
+/* stop the channels, unbind them from the frame and release the frame and
+   the buffers - a deinit, and the roll back of an init which fails after
+   the channels are stopped, so the next init allocates again */
+static uint32_t fs_etpu_spi_master_release(
+    struct spi_master_instance_t *p_spi_master_instance)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t err_code = 0;
+    uint16_t frame_bytes = _FRAME_SIZE_SPI_master_;
+    int32_t i;
+
+    if (p_spi_master_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    for (i = -1; i <= 1; i++)
+    {
+        fs_etpu_disable_ext(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num + i);
+        eTPU->CHAN[p_spi_master_instance->clock_chan_num + i].CR.R = 0;
+    }
+
+    /* buffers in reverse order of allocation, then the frame */
+    fs_etpu_spi_free_pse(p_spi_master_instance->em, &p_spi_master_instance->counters_pse,
+        &p_spi_master_instance->counters_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_master_instance->em, &p_spi_master_instance->stream_buffer_pse,
+        &p_spi_master_instance->stream_buffer_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_master_instance->em, &p_spi_master_instance->chain_buffer_pse,
+        &p_spi_master_instance->chain_buffer_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_master_instance->em, &p_spi_master_instance->burst_buffer_pse,
+        &p_spi_master_instance->burst_buffer_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_master_instance->em, &p_spi_master_instance->angle_table_pse,
+        &p_spi_master_instance->angle_table_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_master_instance->em, &p_spi_master_instance->crc_pse,
+        &p_spi_master_instance->crc_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_master_instance->em, &p_spi_master_instance->cpba_pse,
+        &frame_bytes, &err_code);
+    p_spi_master_instance->cpba = 0;
+
+    return err_code;
+}
 
 uint32_t fs_etpu_spi_master_init(
     struct spi_master_instance_t *p_spi_master_instance,
@@ -16,9 +620,10 @@ uint32_t fs_etpu_spi_master_init(
     volatile struct eTPU_struct * eTPU;
     uint32_t timer_freq;
     uint32_t half_period;
+    uint32_t ss_chan_pack;
     int32_t i;
-    uint32_t timer_freq_mhz, timer_freq_khz, timer_freq_remainder, delay_calc_temp;
     uint32_t mode;
+    uint32_t err_code = 0;
 
     if (p_spi_master_instance->em == EM_AB)
     {
@@ -59,6 +664,11 @@ uint32_t fs_etpu_spi_master_init(
         }
     }
 
+    if (fs_etpu_spi_master_check(p_spi_master_instance, p_spi_master_config, timer_freq))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
     /* first disable channels */
     fs_etpu_disable_ext(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num - 1);
     fs_etpu_disable_ext(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num);
@@ -69,12 +679,12 @@ uint32_t fs_etpu_spi_master_init(
     {
         /* get parameter RAM for channel frame */
         p_spi_master_instance->cpba = fs_etpu_malloc_ext(p_spi_master_instance->em, _FRAME_SIZE_SPI_master_);
-        p_spi_master_instance->cpba_pse = (void*)((uint32_t)p_spi_master_instance->cpba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
-
         if (p_spi_master_instance->cpba  == 0)
         {
+            fs_etpu_spi_master_release(p_spi_master_instance);
             return (FS_ETPU_ERROR_MALLOC);
         }
+        p_spi_master_instance->cpba_pse = (void*)((uint32_t)p_spi_master_instance->cpba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
     }
     else  /* set cpba to what is in the CR register */
     {
@@ -85,44 +695,176 @@ uint32_t fs_etpu_spi_master_init(
     /* intialize channel frame */
     ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_BF_UNIT_0000._BF._CPOL = p_spi_master_config->clock_polarity;
     ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_bit_count = p_spi_master_config->transfer_size;
+    /* the select list is packed 6 bits per entry, 0x3f marks an unused entry */
+    ss_chan_pack = 0;
     for (i = 0; i < FS_ETPU_SPI_MASTER_MAX_SLAVE_SELECT_CNT; i++)
     {
-        ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_chan_list[i] = p_spi_master_instance->slave_select_chan_list[i];
+        if (p_spi_master_instance->slave_select_chan_list[i] == 0xff)
+        {
+            ss_chan_pack |= (uint32_t)0x3f << (6 * i);
+        }
+        else
+        {
+            ss_chan_pack |= (uint32_t)(p_spi_master_instance->slave_select_chan_list[i] & 0x1f) << (6 * i);
+        }
     }
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_slave_select_chan_pack = ss_chan_pack;
     half_period = timer_freq / (p_spi_master_config->baud_rate_hz * 2);
     ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_half_period = half_period;
-    timer_freq_mhz = timer_freq / 1000000;
-    timer_freq_remainder = timer_freq - (timer_freq_mhz * 1000000);
-    delay_calc_temp = timer_freq_mhz * p_spi_master_config->slave_select_delay_us;
-    timer_freq_khz = timer_freq_remainder / 1000; //666
-    timer_freq_remainder = timer_freq_remainder - (timer_freq_khz * 1000);
-    delay_calc_temp += (timer_freq_khz * p_spi_master_config->slave_select_delay_us) / 1000;
-    delay_calc_temp += (timer_freq_remainder * p_spi_master_config->slave_select_delay_us) / 1000000;
-    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_slave_select_delay = delay_calc_temp;
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_miso_sample_delay = p_spi_master_config->miso_sample_delay_ticks;
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_slave_select_delay =
+        fs_etpu_spi_us_to_ticks(timer_freq, p_spi_master_config->slave_select_delay_us);
 
-    /* function mode */
-    if (p_spi_master_config->clock_phase == 1)
+    /* decoder addressed slave select */
+    if (p_spi_master_instance->ss_decoder_addr_bit_cnt != 0)
     {
-        mode = FS_ETPU_SPI_MASTER_CPHA_1_FM0;
+        ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_ss_addr_chan = p_spi_master_instance->ss_decoder_addr_chan;
     }
-    else
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_ss_addr_bit_count = p_spi_master_instance->ss_decoder_addr_bit_cnt;
+
+    /* CRC */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_master_instance->em, &p_spi_master_instance->crc_pse,
+        &p_spi_master_instance->crc_bytes,
+        (p_spi_master_config->crc_size == 0) ? 0 : sizeof(struct spi_master_crc_pse_t));
+    if (err_code != 0)
     {
-        mode = FS_ETPU_SPI_MASTER_CPHA_0_FM0;
+        fs_etpu_spi_master_release(p_spi_master_instance);
+        return err_code;
     }
-    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+    if (p_spi_master_instance->crc_pse != 0)
     {
-        mode |= (FS_ETPU_SPI_MASTER_SHIFT_DIR_LSB_FM1 << 1);
+        struct spi_master_crc_pse_t *p_crc;
+
+        p_crc = (struct spi_master_crc_pse_t*)p_spi_master_instance->crc_pse;
+        p_crc->poly = FS_ETPU_SPI_CRC_ALIGN(p_spi_master_config->crc_polynomial, p_spi_master_config->crc_size);
+        p_crc->init = FS_ETPU_SPI_CRC_ALIGN(p_spi_master_config->crc_init, p_spi_master_config->crc_size);
+        p_crc->xorout = FS_ETPU_SPI_CRC_ALIGN(p_spi_master_config->crc_xorout, p_spi_master_config->crc_size);
+        p_crc->residue = fs_etpu_spi_crc_residue(p_spi_master_config->crc_size,
+            p_spi_master_config->crc_polynomial, p_spi_master_config->crc_xorout);
+        p_crc->bit_count = p_spi_master_config->crc_size;
+        p_crc->error = 0;
     }
-    else
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_crc =
+        fs_etpu_spi_pse_addr(p_spi_master_instance->crc_pse);
+
+    /* angle schedule - the entries were checked above */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_master_instance->em, &p_spi_master_instance->angle_table_pse,
+        &p_spi_master_instance->angle_table_bytes,
+        p_spi_master_instance->angle_entry_cnt * sizeof(struct spi_master_angle_entry_pse_t));
+    if (err_code != 0)
     {
-        mode |= (FS_ETPU_SPI_MASTER_SHIFT_DIR_MSB_FM1 << 1);
+        fs_etpu_spi_master_release(p_spi_master_instance);
+        return err_code;
     }
-    eTPU->CHAN[p_spi_master_instance->clock_chan_num].SCR.R = mode;
-
-    /* write hsr */
-    if (p_spi_master_config->timer == FS_ETPU_TCR1)
+    for (i = 0; i < p_spi_master_instance->angle_entry_cnt; i++)
     {
-        eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_INIT_TCR1_HSR;
+        fs_etpu_spi_master_set_angle_entry(p_spi_master_instance, p_spi_master_config, i);
+        ((struct spi_master_angle_entry_pse_t*)p_spi_master_instance->angle_table_pse)[i].data_in = 0;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_angle_table =
+        fs_etpu_spi_pse_addr(p_spi_master_instance->angle_table_pse);
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_angle_table_cnt = p_spi_master_instance->angle_entry_cnt;
+
+    /* burst read block */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_master_instance->em, &p_spi_master_instance->burst_buffer_pse,
+        &p_spi_master_instance->burst_buffer_bytes, (p_spi_master_instance->burst_word_cnt_max == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_master_burst_pse_t, uint32_t, p_spi_master_instance->burst_word_cnt_max));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_master_release(p_spi_master_instance);
+        return err_code;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_burst =
+        fs_etpu_spi_pse_addr(p_spi_master_instance->burst_buffer_pse);
+
+    /* daisy chain block and latch */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_master_instance->em, &p_spi_master_instance->chain_buffer_pse,
+        &p_spi_master_instance->chain_buffer_bytes, (p_spi_master_instance->chain_word_cnt_max == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_master_chain_pse_t, struct spi_master_chain_entry_pse_t,
+            p_spi_master_instance->chain_word_cnt_max));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_master_release(p_spi_master_instance);
+        return err_code;
+    }
+    if (p_spi_master_instance->chain_buffer_pse != 0)
+    {
+        struct spi_master_chain_pse_t *p_chain;
+
+        p_chain = (struct spi_master_chain_pse_t*)p_spi_master_instance->chain_buffer_pse;
+        p_chain->xfer.run = 0;
+        p_chain->refresh_period = fs_etpu_spi_us_to_ticks(timer_freq, p_spi_master_config->chain_refresh_period_us);
+        p_chain->latch_width = fs_etpu_spi_us_to_ticks(timer_freq, p_spi_master_config->latch_width_us);
+        p_chain->latch_polarity = p_spi_master_config->latch_polarity;
+        p_chain->latch_chan = (p_spi_master_config->latch_width_us == 0) ? 0xff : p_spi_master_instance->latch_chan;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_chain =
+        fs_etpu_spi_pse_addr(p_spi_master_instance->chain_buffer_pse);
+
+    /* stream block */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_master_instance->em, &p_spi_master_instance->stream_buffer_pse,
+        &p_spi_master_instance->stream_buffer_bytes, (p_spi_master_instance->stream_word_cnt == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_master_stream_pse_t, uint32_t, p_spi_master_instance->stream_word_cnt));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_master_release(p_spi_master_instance);
+        return err_code;
+    }
+    if (p_spi_master_instance->stream_buffer_pse != 0)
+    {
+        struct spi_master_stream_pse_t *p_stream;
+
+        p_stream = (struct spi_master_stream_pse_t*)p_spi_master_instance->stream_buffer_pse;
+        p_stream->xfer.cnt = p_spi_master_instance->stream_word_cnt;
+        p_stream->xfer.index = 0;
+        p_stream->xfer.run = 0;
+        p_stream->frame_cnt = p_spi_master_config->stream_frame_word_cnt;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_stream =
+        fs_etpu_spi_pse_addr(p_spi_master_instance->stream_buffer_pse);
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_xfer_mode = FS_ETPU_SPI_MASTER_XFER_WORD;
+
+    /* counters, cleared here as the channels are stopped */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_master_instance->em, &p_spi_master_instance->counters_pse,
+        &p_spi_master_instance->counters_bytes,
+        (p_spi_master_instance->counter_enable == 0) ? 0 : sizeof(struct spi_master_counters_pse_t));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_master_release(p_spi_master_instance);
+        return err_code;
+    }
+    if (p_spi_master_instance->counters_pse != 0)
+    {
+        fs_memset32_ext((uint32_t*)p_spi_master_instance->counters_pse, 0, sizeof(struct spi_master_counters_pse_t));
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_counters =
+        fs_etpu_spi_pse_addr(p_spi_master_instance->counters_pse);
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_rx_full = 0;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_tx_fresh = 0;
+
+    /* function mode - DDR puts the first bit out like CPHA 0 */
+    if ((p_spi_master_config->clock_phase == 1) && (p_spi_master_config->ddr == 0))
+    {
+        mode = FS_ETPU_SPI_MASTER_CPHA_1_FM0;
+    }
+    else
+    {
+        mode = FS_ETPU_SPI_MASTER_CPHA_0_FM0;
+    }
+    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+    {
+        mode |= (FS_ETPU_SPI_MASTER_SHIFT_DIR_LSB_FM1 << 1);
+    }
+    else
+    {
+        mode |= (FS_ETPU_SPI_MASTER_SHIFT_DIR_MSB_FM1 << 1);
+    }
+    eTPU->CHAN[p_spi_master_instance->clock_chan_num].SCR.R = mode;
+
+    /* write hsr */
+    if (p_spi_master_config->timer == FS_ETPU_TCR1)
+    {
+        eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_INIT_TCR1_HSR;
     }
     else
     {
@@ -132,17 +874,30 @@ uint32_t fs_etpu_spi_master_init(
 
     /* final channel configuration */
     /* MISO and MOSI channels have same base address as SCLK */
-    eTPU->CHAN[p_spi_master_instance->clock_chan_num - 1].CR.R =
-        (uint32_t) (((uint32_t)p_spi_master_instance->cpba & 0x3fff) >> 3);
+    if (p_spi_master_config->miso_sample_delay_ticks != 0)
+    {
+        /* MISO is serviced when sampled on its own matches */
+        eTPU->CHAN[p_spi_master_instance->clock_chan_num - 1].CR.R =
+            (p_spi_master_instance->priority << 28) + 
+            fs_etpu_spi_master_function(p_spi_master_config) +
+            (uint32_t) (((uint32_t)p_spi_master_instance->cpba & 0x3fff) >> 3);
+    }
+    else
+    {
+        eTPU->CHAN[p_spi_master_instance->clock_chan_num - 1].CR.R =
+            (uint32_t) (((uint32_t)p_spi_master_instance->cpba & 0x3fff) >> 3);
+    }
     eTPU->CHAN[p_spi_master_instance->clock_chan_num + 1].CR.R =
         (uint32_t) (((uint32_t)p_spi_master_instance->cpba & 0x3fff) >> 3);
 
     eTPU->CHAN[p_spi_master_instance->clock_chan_num].CR.R =
         (p_spi_master_instance->priority << 28) + 
-        (_ENTRY_TABLE_TYPE_SPI_master_ << 24) +
-        (_FUNCTION_NUM_SPI_master_ << 16) + 
+        fs_etpu_spi_master_function(p_spi_master_config) +
         (uint32_t) (((uint32_t)p_spi_master_instance->cpba & 0x3fff) >> 3);
 
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_attach_sum =
+        fs_etpu_spi_master_attach_sum(p_spi_master_instance);
+
     return 0;
 }
 
@@ -153,6 +908,7 @@ uint32_t fs_etpu_spi_master_transmit_data(
     int8_t slave_select_index)
 {
     volatile struct eTPU_struct * eTPU;
+    uint32_t ss_chan, ss_addr;
 
     if (p_spi_master_instance->em == EM_AB)
     {
@@ -163,6 +919,11 @@ uint32_t fs_etpu_spi_master_transmit_data(
         eTPU = eTPU_C;
     }
 
+    if (fs_etpu_spi_master_slave_select(p_spi_master_instance, slave_select_index, &ss_chan, &ss_addr))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
     /* pre-shift the data if necessary */
     if (p_spi_master_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
     {
@@ -170,40 +931,780 @@ uint32_t fs_etpu_spi_master_transmit_data(
         data <<= (24 - p_spi_master_config->transfer_size);
     }
     ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_data_out_reg = data;
-    if (slave_select_index == -1)
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_xfer_mode = FS_ETPU_SPI_MASTER_XFER_WORD;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_chan = ss_chan;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_addr = ss_addr;
+    eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_RUN_HSR;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data)
+{
+    uint32_t data;
+    uint32_t mask = (1 << p_spi_master_config->transfer_size) - 1;
+
+    data = ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_data_in_reg;
+    /* shift data to correct bits if necessary */
+    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+    {
+        /* LSB first, need to shift down into position */
+        data >>= (24 - p_spi_master_config->transfer_size);
+    }
+    *p_data = data & mask;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_crc_error(
+    struct spi_master_instance_t *p_spi_master_instance,
+    uint8_t *p_crc_error)
+{
+    if (p_spi_master_instance->crc_pse == 0)
     {
-        ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_chan = 0xff;
+        *p_crc_error = 0;
     }
     else
     {
-        ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_chan = 
-            p_spi_master_instance->slave_select_chan_list[slave_select_index];
+        struct spi_master_crc_pse_t *p_crc = (struct spi_master_crc_pse_t*)p_spi_master_instance->crc_pse;
+
+        /* the eTPU only sets the error, it is cleared here once seen */
+        *p_crc_error = p_crc->error & 0xff;
+        if (*p_crc_error != 0)
+        {
+            p_crc->error = 0;
+        }
     }
-    eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_RUN_HSR;
 
     return 0;
 }
 
-uint32_t fs_etpu_spi_master_get_data(
+uint32_t fs_etpu_spi_master_set_angle_entry(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint8_t entry_index)
+{
+    struct spi_master_angle_entry_t *p_entry;
+    struct spi_master_angle_entry_pse_t *p_entry_pse;
+    uint32_t data;
+    uint32_t ss_chan, ss_addr;
+
+    if (entry_index >= p_spi_master_instance->angle_entry_cnt)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    p_entry = &p_spi_master_instance->angle_table[entry_index];
+    p_entry_pse = &((struct spi_master_angle_entry_pse_t*)p_spi_master_instance->angle_table_pse)[entry_index];
+
+    /* pre-shift the data if necessary */
+    data = p_entry->data;
+    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+    {
+        /* MSB first, need to shift to the top */
+        data <<= (24 - p_spi_master_config->transfer_size);
+    }
+    p_entry_pse->data_out = data;
+    if (fs_etpu_spi_master_slave_select(p_spi_master_instance, p_entry->slave_select_index, &ss_chan, &ss_addr))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    p_entry_pse->slave_select_chan = ss_chan;
+    p_entry_pse->slave_select_addr = ss_addr;
+    p_entry_pse->angle = p_entry->angle;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_angle_data(
     struct spi_master_instance_t *p_spi_master_instance,
     struct spi_master_config_t   *p_spi_master_config,
+    uint8_t entry_index,
     uint32_t *p_data)
 {
     uint32_t data;
     uint32_t mask = (1 << p_spi_master_config->transfer_size) - 1;
 
-    data = ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_data_in_reg;
-    /* shift data to correct bits if necessary */
-    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+    if (entry_index >= p_spi_master_instance->angle_entry_cnt)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    data = ((struct spi_master_angle_entry_pse_t*)p_spi_master_instance->angle_table_pse)[entry_index].data_in;
+    /* shift data to correct bits if necessary */
+    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+    {
+        /* LSB first, need to shift down into position */
+        data >>= (24 - p_spi_master_config->transfer_size);
+    }
+    *p_data = data & mask;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_burst_read(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t command,
+    uint8_t command_size,
+    uint32_t dummy_data,
+    uint8_t word_cnt,
+    int8_t slave_select_index)
+{
+    volatile struct eTPU_struct * eTPU;
+    struct spi_master_burst_pse_t *p_burst;
+    uint32_t ss_chan, ss_addr;
+
+    if (p_spi_master_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    if (fs_etpu_spi_master_slave_select(p_spi_master_instance, slave_select_index, &ss_chan, &ss_addr))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    if ((word_cnt == 0) || (word_cnt > p_spi_master_instance->burst_word_cnt_max) ||
+        (command_size == 0) || (command_size > 24) || (p_spi_master_config->ddr != 0))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    p_burst = (struct spi_master_burst_pse_t*)p_spi_master_instance->burst_buffer_pse;
+
+    /* pre-shift the command and dummy data if necessary */
+    if (p_spi_master_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+    {
+        /* MSB first, need to shift to the top */
+        command <<= (24 - command_size);
+        dummy_data <<= (24 - p_spi_master_config->transfer_size);
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_data_out_reg = command;
+    p_burst->dummy = dummy_data;
+    p_burst->cmd_bit_count = command_size;
+    p_burst->xfer.cnt = word_cnt;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_xfer_mode = FS_ETPU_SPI_MASTER_XFER_BURST;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_chan = ss_chan;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_addr = ss_addr;
+    eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_RUN_HSR;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_burst_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint8_t word_cnt)
+{
+    uint32_t data;
+    uint32_t mask = (1 << p_spi_master_config->transfer_size) - 1;
+    uint8_t i;
+
+    if (word_cnt > p_spi_master_instance->burst_word_cnt_max)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    for (i = 0; i < word_cnt; i++)
+    {
+        data = ((struct spi_master_burst_pse_t*)p_spi_master_instance->burst_buffer_pse)->rx_buf[i];
+        /* shift data to correct bits if necessary */
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            /* LSB first, need to shift down into position */
+            data >>= (24 - p_spi_master_config->transfer_size);
+        }
+        p_data[i] = data & mask;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_chain_transmit(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint8_t word_cnt,
+    int8_t slave_select_index,
+    uint8_t refresh)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t ss_chan, ss_addr;
+
+    if (p_spi_master_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    /* angle mode owns the match B timing */
+    if ((word_cnt == 0) || (p_spi_master_instance->angle_entry_cnt != 0) ||
+        (p_spi_master_config->ddr != 0) ||
+        ((refresh != 0) && (p_spi_master_config->chain_refresh_period_us == 0)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    if (fs_etpu_spi_master_slave_select(p_spi_master_instance, slave_select_index, &ss_chan, &ss_addr))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    if (fs_etpu_spi_master_set_chain_data(p_spi_master_instance, p_spi_master_config, p_data, word_cnt))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    ((struct spi_master_chain_pse_t*)p_spi_master_instance->chain_buffer_pse)->xfer.cnt = word_cnt;
+    ((struct spi_master_chain_pse_t*)p_spi_master_instance->chain_buffer_pse)->xfer.run = refresh;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_xfer_mode = FS_ETPU_SPI_MASTER_XFER_CHAIN;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_chan = ss_chan;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_addr = ss_addr;
+    eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_RUN_HSR;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_set_chain_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint8_t word_cnt)
+{
+    uint32_t data;
+    uint8_t i;
+
+    if (word_cnt > p_spi_master_instance->chain_word_cnt_max)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    /* each word is written coherently, a refresh in progress may mix old
+       and new words */
+    for (i = 0; i < word_cnt; i++)
+    {
+        data = p_data[i];
+        /* pre-shift the data if necessary */
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+        {
+            /* MSB first, need to shift to the top */
+            data <<= (24 - p_spi_master_config->transfer_size);
+        }
+        ((struct spi_master_chain_pse_t*)p_spi_master_instance->chain_buffer_pse)->entry[i].data_out = data;
+    }
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_chain_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint8_t word_cnt)
+{
+    uint32_t data;
+    uint32_t mask = (1 << p_spi_master_config->transfer_size) - 1;
+    uint8_t i;
+
+    if (word_cnt > p_spi_master_instance->chain_word_cnt_max)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    for (i = 0; i < word_cnt; i++)
+    {
+        data = ((struct spi_master_chain_pse_t*)p_spi_master_instance->chain_buffer_pse)->entry[i].data_in;
+        /* shift data to correct bits if necessary */
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            /* LSB first, need to shift down into position */
+            data >>= (24 - p_spi_master_config->transfer_size);
+        }
+        p_data[i] = data & mask;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_chain_stop(
+    struct spi_master_instance_t *p_spi_master_instance)
+{
+    if (p_spi_master_instance->chain_buffer_pse == 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* a transfer in progress completes, no further refresh is scheduled */
+    ((struct spi_master_chain_pse_t*)p_spi_master_instance->chain_buffer_pse)->xfer.run = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_stream_start(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    int8_t frame_sync_index)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t ss_chan, ss_addr;
+
+    if (p_spi_master_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    /* angle mode owns the match B timing, DDR does not chain words */
+    if ((p_spi_master_instance->stream_word_cnt == 0) ||
+        (p_spi_master_config->stream_frame_word_cnt < 2) ||
+        (p_spi_master_instance->angle_entry_cnt != 0) ||
+        (p_spi_master_config->ddr != 0))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    if (fs_etpu_spi_master_slave_select(p_spi_master_instance, frame_sync_index, &ss_chan, &ss_addr))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    /* the ring must have been filled with fs_etpu_spi_master_set_stream_data */
+    ((struct spi_master_stream_pse_t*)p_spi_master_instance->stream_buffer_pse)->xfer.run = 1;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_xfer_mode = FS_ETPU_SPI_MASTER_XFER_STREAM;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_chan = ss_chan;
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_slave_select_addr = ss_addr;
+    eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_RUN_HSR;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_set_stream_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint16_t first_index,
+    uint16_t word_cnt)
+{
+    uint32_t data;
+    uint16_t i;
+
+    if ((uint32_t)first_index + word_cnt > p_spi_master_instance->stream_word_cnt)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    for (i = 0; i < word_cnt; i++)
+    {
+        data = p_data[i];
+        /* pre-shift the data if necessary */
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+        {
+            /* MSB first, need to shift to the top */
+            data <<= (24 - p_spi_master_config->transfer_size);
+        }
+        ((struct spi_master_stream_pse_t*)p_spi_master_instance->stream_buffer_pse)->buf[first_index + i] = data;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_tx_fresh = 1;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_stream_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint16_t first_index,
+    uint16_t word_cnt)
+{
+    uint32_t data;
+    uint32_t mask = (1 << p_spi_master_config->transfer_size) - 1;
+    uint16_t i;
+
+    if ((uint32_t)first_index + word_cnt > p_spi_master_instance->stream_word_cnt)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    for (i = 0; i < word_cnt; i++)
+    {
+        data = ((struct spi_master_stream_pse_t*)p_spi_master_instance->stream_buffer_pse)->buf[first_index + i];
+        /* shift data to correct bits if necessary */
+        if (p_spi_master_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            /* LSB first, need to shift down into position */
+            data >>= (24 - p_spi_master_config->transfer_size);
+        }
+        p_data[i] = data & mask;
+    }
+    ((etpu_if_SPI_master_CHANNEL_FRAME*)p_spi_master_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_stream_index(
+    struct spi_master_instance_t *p_spi_master_instance,
+    uint16_t *p_index)
+{
+    if (p_spi_master_instance->stream_buffer_pse == 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    *p_index = ((struct spi_master_stream_pse_t*)p_spi_master_instance->stream_buffer_pse)->xfer.index & 0xffffff;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_stream_stop(
+    struct spi_master_instance_t *p_spi_master_instance)
+{
+    if (p_spi_master_instance->stream_buffer_pse == 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* clocking continues to the end of the current frame */
+    ((struct spi_master_stream_pse_t*)p_spi_master_instance->stream_buffer_pse)->xfer.run = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_get_counters(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_counters_t        *p_counters)
+{
+    volatile struct eTPU_struct * eTPU;
+    struct spi_master_counters_pse_t *p_cnt;
+
+    if (p_spi_master_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    /* only kept if enabled at init */
+    if (p_spi_master_instance->counters_pse == 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    p_cnt = (struct spi_master_counters_pse_t*)p_spi_master_instance->counters_pse;
+    /* the snapshot HSR must not overwrite a pending request */
+    if (fs_etpu_get_hsr_ext(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num) != 0)
+    {
+        return (FS_ETPU_ERROR_TIMING);
+    }
+    /* the eTPU copies and clears the counters in one thread */
+    eTPU->CHAN[p_spi_master_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_MASTER_COUNTERS_HSR;
+    if (fs_etpu_spi_wait_hsr(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num) != 0)
+    {
+        return (FS_ETPU_ERROR_TIMING);
+    }
+
+    p_counters->rx_overrun_cnt = p_cnt->snap_rx_overrun_cnt & 0xffffff;
+    p_counters->tx_underrun_cnt = p_cnt->snap_tx_underrun_cnt & 0xffffff;
+    p_counters->timeout_cnt = 0;
+    p_counters->abort_cnt = 0;
+    p_counters->error_cnt = p_cnt->snap_error_cnt & 0xffffff;
+    p_counters->glitch_cnt = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_master_deinit(
+    struct spi_master_instance_t *p_spi_master_instance)
+{
+    /* a pending init must not run on released memory */
+    if (fs_etpu_get_hsr_ext(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num) != 0)
+    {
+        return (FS_ETPU_ERROR_TIMING);
+    }
+
+    return fs_etpu_spi_master_release(p_spi_master_instance);
+}
+
+uint32_t fs_etpu_spi_master_reattach(
+    struct spi_master_instance_t *p_spi_master_instance)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t err_code = 0;
+
+    if (p_spi_master_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    if (eTPU->CHAN[p_spi_master_instance->clock_chan_num].CR.B.CPBA == 0)
+    {
+        return (FS_ETPU_ERROR_ADDRESS);
+    }
+    p_spi_master_instance->cpba = fs_etpu_get_cpba_ext(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num);
+    p_spi_master_instance->cpba_pse = fs_etpu_get_cpba_pse_ext(p_spi_master_instance->em, p_spi_master_instance->clock_chan_num);
+
+    /* the buffers are where the running frame points */
+    p_spi_master_instance->angle_table_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_angle_table,
+        p_spi_master_instance->angle_entry_cnt);
+    p_spi_master_instance->burst_buffer_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_burst,
+        p_spi_master_instance->burst_word_cnt_max);
+    p_spi_master_instance->chain_buffer_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_chain,
+        p_spi_master_instance->chain_word_cnt_max);
+    p_spi_master_instance->stream_buffer_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_stream,
+        p_spi_master_instance->stream_word_cnt);
+    /* the CRC and counter blocks exist when the frame points to them */
+    p_spi_master_instance->crc_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_crc,
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_crc & 0xffffff);
+    p_spi_master_instance->counters_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_counters,
+        ((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_counters & 0xffffff);
+
+    if (fs_etpu_spi_master_attach_sum(p_spi_master_instance) !=
+        (((etpu_if_SPI_master_CHANNEL_FRAME_PSE*)p_spi_master_instance->cpba_pse)->_attach_sum & 0xffffff))
+    {
+        /* not the frame of this instance - it needs a cold init */
+        p_spi_master_instance->cpba = 0;
+        p_spi_master_instance->cpba_pse = 0;
+        p_spi_master_instance->angle_table_pse = 0;
+        p_spi_master_instance->burst_buffer_pse = 0;
+        p_spi_master_instance->chain_buffer_pse = 0;
+        p_spi_master_instance->stream_buffer_pse = 0;
+        p_spi_master_instance->crc_pse = 0;
+        p_spi_master_instance->counters_pse = 0;
+        return (FS_ETPU_ERROR_CHECKSUM);
+    }
+
+    /* the checksum holds the counts the buffers were sized by at init */
+    p_spi_master_instance->angle_table_bytes = (p_spi_master_instance->angle_table_pse == 0) ? 0 :
+        p_spi_master_instance->angle_entry_cnt * sizeof(struct spi_master_angle_entry_pse_t);
+    p_spi_master_instance->burst_buffer_bytes = (p_spi_master_instance->burst_buffer_pse == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_master_burst_pse_t, uint32_t, p_spi_master_instance->burst_word_cnt_max);
+    p_spi_master_instance->chain_buffer_bytes = (p_spi_master_instance->chain_buffer_pse == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_master_chain_pse_t, struct spi_master_chain_entry_pse_t,
+            p_spi_master_instance->chain_word_cnt_max);
+    p_spi_master_instance->stream_buffer_bytes = (p_spi_master_instance->stream_buffer_pse == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_master_stream_pse_t, uint32_t, p_spi_master_instance->stream_word_cnt);
+    p_spi_master_instance->crc_bytes = (p_spi_master_instance->crc_pse == 0) ? 0 :
+        sizeof(struct spi_master_crc_pse_t);
+    p_spi_master_instance->counters_bytes = (p_spi_master_instance->counters_pse == 0) ? 0 :
+        sizeof(struct spi_master_counters_pse_t);
+
+    /* the allocator takes the memory back */
+    fs_etpu_spi_claim_pse(p_spi_master_instance->em, p_spi_master_instance->cpba_pse,
+        _FRAME_SIZE_SPI_master_, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_master_instance->em, p_spi_master_instance->angle_table_pse,
+        p_spi_master_instance->angle_table_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_master_instance->em, p_spi_master_instance->crc_pse,
+        p_spi_master_instance->crc_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_master_instance->em, p_spi_master_instance->burst_buffer_pse,
+        p_spi_master_instance->burst_buffer_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_master_instance->em, p_spi_master_instance->chain_buffer_pse,
+        p_spi_master_instance->chain_buffer_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_master_instance->em, p_spi_master_instance->stream_buffer_pse,
+        p_spi_master_instance->stream_buffer_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_master_instance->em, p_spi_master_instance->counters_pse,
+        p_spi_master_instance->counters_bytes, &err_code);
+
+    return err_code;
+}
+
+
+/* SS channel of a slave device, device 0 is ss_chan_num */
+static uint8_t fs_etpu_spi_slave_ss_chan(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    uint8_t device_index)
+{
+    if (device_index == 0)
+    {
+        return p_spi_slave_instance->ss_chan_num;
+    }
+    return p_spi_slave_instance->ss_device_chan_list[device_index - 1];
+}
+
+/* number of SS channels of a slave */
+static uint8_t fs_etpu_spi_slave_ss_cnt(
+    struct spi_slave_instance_t *p_spi_slave_instance)
+{
+    if (p_spi_slave_instance->ss_chan_num == 0xff)
+    {
+        return 0;
+    }
+    if (p_spi_slave_instance->ss_device_cnt > 1)
+    {
+        return p_spi_slave_instance->ss_device_cnt;
+    }
+    return 1;
+}
+
+/* attach checksum of a slave instance, from its channels and buffers */
+static uint32_t fs_etpu_spi_slave_attach_sum(
+    struct spi_slave_instance_t *p_spi_slave_instance)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t words[4 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT + 8];
+    uint8_t ss_cnt, i;
+
+    if (p_spi_slave_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    ss_cnt = fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance);
+    words[0] = FS_ETPU_SPI_ATTACH_MAGIC_SLAVE;
+    for (i = 0; i < 3; i++)
+    {
+        words[1 + i] = eTPU->CHAN[p_spi_slave_instance->clock_chan_num - 1 + i].CR.R & FS_ETPU_SPI_ATTACH_CR_MASK;
+    }
+    for (i = 0; i < FS_ETPU_SPI_SLAVE_MAX_SS_CNT; i++)
+    {
+        words[4 + i] = (i < ss_cnt) ?
+            (eTPU->CHAN[fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i)].CR.R & FS_ETPU_SPI_ATTACH_CR_MASK) : 0;
+    }
+    words[4 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = ss_cnt | (p_spi_slave_instance->reg_addr_bit_cnt << 8) |
+        ((uint32_t)p_spi_slave_instance->frame_word_cnt_max << 16);
+    words[5 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = fs_etpu_spi_pse_addr(p_spi_slave_instance->reg_table_pse);
+    words[6 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = fs_etpu_spi_pse_addr(p_spi_slave_instance->frame_buffer_pse);
+    words[7 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = fs_etpu_spi_pse_addr(p_spi_slave_instance->dev_buffer_pse);
+    words[8 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = fs_etpu_spi_pse_addr(p_spi_slave_instance->crc_pse);
+    words[9 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = fs_etpu_spi_pse_addr(p_spi_slave_instance->long_pse);
+    words[10 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = fs_etpu_spi_pse_addr(p_spi_slave_instance->edge_pse);
+    words[11 + FS_ETPU_SPI_SLAVE_MAX_SS_CNT] = fs_etpu_spi_pse_addr(p_spi_slave_instance->counters_pse);
+
+    /* folded to the 24 bits of the frame word */
+    return fs_etpu_checksum_ext(words, sizeof(words)) & 0xffffff;
+}
+
+/* slave configuration checks - all made before init stops a channel or
+   takes any DATA RAM, so a rejected configuration leaves a running
+   instance as it was */
+static uint32_t fs_etpu_spi_slave_check(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config)
+{
+    uint8_t ss_cnt = fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance);
+    uint8_t reg_cmd_bits = 0;
+
+    if (ss_cnt > FS_ETPU_SPI_SLAVE_MAX_SS_CNT)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* CRC - MSB first, its bits are counted down from the transfer size */
+    if ((p_spi_slave_config->crc_size != 0) &&
+        ((p_spi_slave_config->shift_direction != FS_ETPU_SPI_MSB_FIRST) ||
+         (p_spi_slave_config->crc_size > p_spi_slave_config->transfer_size)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* DDR / single edge - one thread per bit, no CRC */
+    if (((p_spi_slave_config->ddr != 0) || (p_spi_slave_config->single_edge != 0)) &&
+        (p_spi_slave_config->crc_size != 0))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* register map - MSB first, no CRC, data bits after the command */
+    if (p_spi_slave_instance->reg_addr_bit_cnt != 0)
+    {
+        reg_cmd_bits = p_spi_slave_instance->reg_addr_bit_cnt + (p_spi_slave_config->reg_write_enable != 0);
+        if ((p_spi_slave_instance->reg_addr_bit_cnt > FS_ETPU_SPI_SLAVE_MAX_REG_ADDR_BIT_CNT) ||
+            (p_spi_slave_config->shift_direction != FS_ETPU_SPI_MSB_FIRST) ||
+            (p_spi_slave_config->crc_size != 0) ||
+            (reg_cmd_bits >= p_spi_slave_config->transfer_size))
+        {
+            return (FS_ETPU_ERROR_VALUE);
+        }
+    }
+    /* SS delimited frames - need an SS, no CRC */
+    if ((p_spi_slave_instance->frame_word_cnt_max != 0) &&
+        ((p_spi_slave_instance->ss_chan_num == 0xff) || (p_spi_slave_config->crc_size != 0)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    /* long words - chained in two segments, which the word options do not follow */
+    if ((p_spi_slave_config->transfer_size > FS_ETPU_SPI_SLAVE_MAX_TRANSFER_SIZE) ||
+        ((p_spi_slave_config->transfer_size > 24) &&
+         ((p_spi_slave_config->crc_size != 0) || (reg_cmd_bits != 0) ||
+          (p_spi_slave_instance->frame_word_cnt_max != 0) || (ss_cnt > 1))))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    return 0;
+}
+
+/* as fs_etpu_spi_master_release, with the SS channels of the devices */
+static uint32_t fs_etpu_spi_slave_release(
+    struct spi_slave_instance_t *p_spi_slave_instance)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t err_code = 0;
+    uint16_t frame_bytes = _FRAME_SIZE_SPI_slave_;
+    uint8_t ss_cnt;
+    uint8_t chan;
+    int32_t i;
+
+    if (p_spi_slave_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    ss_cnt = fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance);
+    for (i = -1; i < ss_cnt + 2; i++)
     {
-        /* LSB first, need to shift down into position */
-        data >>= (24 - p_spi_master_config->transfer_size);
+        chan = (i < 2) ? p_spi_slave_instance->clock_chan_num + i :
+                         fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i - 2);
+        fs_etpu_disable_ext(p_spi_slave_instance->em, chan);
+        eTPU->CHAN[chan].CR.R = 0;
     }
-    *p_data = data & mask;
 
-    return 0;
-}
+    /* buffers in reverse order of allocation, then the frame */
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->counters_pse,
+        &p_spi_slave_instance->counters_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->long_pse,
+        &p_spi_slave_instance->long_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->frame_buffer_pse,
+        &p_spi_slave_instance->frame_buffer_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->reg_table_pse,
+        &p_spi_slave_instance->reg_table_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->crc_pse,
+        &p_spi_slave_instance->crc_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->edge_pse,
+        &p_spi_slave_instance->edge_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->dev_buffer_pse,
+        &p_spi_slave_instance->dev_buffer_bytes, &err_code);
+    fs_etpu_spi_free_pse(p_spi_slave_instance->em, &p_spi_slave_instance->cpba_pse,
+        &frame_bytes, &err_code);
+    p_spi_slave_instance->cpba = 0;
 
+    return err_code;
+}
 
 uint32_t fs_etpu_spi_slave_init(
     struct spi_slave_instance_t *p_spi_slave_instance,
@@ -211,8 +1712,12 @@ uint32_t fs_etpu_spi_slave_init(
 {
     volatile struct eTPU_struct * eTPU;
     uint32_t timer_freq;
-    uint32_t timer_freq_mhz, timer_freq_khz, timer_freq_remainder, timeout_calc_temp;
     uint32_t mode;
+    uint8_t reg_cmd_bits;
+    uint8_t ss_cnt, i;
+    uint32_t ss_chan_pack;
+    struct spi_slave_reg_pse_t *p_reg;
+    uint32_t err_code = 0;
 
     if (p_spi_slave_instance->em == EM_AB)
     {
@@ -253,13 +1758,19 @@ uint32_t fs_etpu_spi_slave_init(
         }
     }
 
+    if (fs_etpu_spi_slave_check(p_spi_slave_instance, p_spi_slave_config))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    ss_cnt = fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance);
+
     /*first disable channels*/
     fs_etpu_disable_ext(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num - 1);
     fs_etpu_disable_ext(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num);
     fs_etpu_disable_ext(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num + 1);
-    if (p_spi_slave_instance->ss_chan_num != 0xff)
+    for (i = 0; i < ss_cnt; i++)
     {
-        fs_etpu_disable_ext(p_spi_slave_instance->em, p_spi_slave_instance->ss_chan_num);
+        fs_etpu_disable_ext(p_spi_slave_instance->em, fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i));
     }
 
     /* get channel frame memory configured */
@@ -267,12 +1778,12 @@ uint32_t fs_etpu_spi_slave_init(
     {
         /* get parameter RAM for channel frame */
         p_spi_slave_instance->cpba = fs_etpu_malloc_ext(p_spi_slave_instance->em, _FRAME_SIZE_SPI_slave_);
-        p_spi_slave_instance->cpba_pse = (void*)((uint32_t)p_spi_slave_instance->cpba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
-
         if (p_spi_slave_instance->cpba  == 0)
         {
+            fs_etpu_spi_slave_release(p_spi_slave_instance);
             return (FS_ETPU_ERROR_MALLOC);
         }
+        p_spi_slave_instance->cpba_pse = (void*)((uint32_t)p_spi_slave_instance->cpba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
     }
     else                        /*set pba to what is in the CR register */
     {
@@ -284,21 +1795,186 @@ uint32_t fs_etpu_spi_slave_init(
     ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_BF_UNIT_0000._BF._use_TCR1 = (p_spi_slave_config->timer == FS_ETPU_TCR1);
     ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_BF_UNIT_0000._BF._CPOL = p_spi_slave_config->clock_polarity;
     ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_bit_count = p_spi_slave_config->transfer_size;
-    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_MISO_chan = p_spi_slave_instance->clock_chan_num - 1;;
+        ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_MISO_chan = p_spi_slave_instance->clock_chan_num - 1;;
     /* if there is no slve select channel, then selected flag must be initialized on (always on) */
     ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_selected_flag = (p_spi_slave_instance->ss_chan_num == 0xff ? 1 : 0);
-    /* calculate the timeout carefully to avoid numerical overflow and avoid floating point use */
-    timer_freq_mhz = timer_freq / 1000000;
-    timer_freq_remainder = timer_freq - (timer_freq_mhz * 1000000);
-    timeout_calc_temp = timer_freq_mhz * p_spi_slave_config->timeout_us;
-    timer_freq_khz = timer_freq_remainder / 1000; //666
-    timer_freq_remainder = timer_freq_remainder - (timer_freq_khz * 1000);
-    timeout_calc_temp += (timer_freq_khz * p_spi_slave_config->timeout_us) / 1000;
-    timeout_calc_temp += (timer_freq_remainder * p_spi_slave_config->timeout_us) / 1000000;
-    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_timeout = timeout_calc_temp;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_timeout =
+        fs_etpu_spi_us_to_ticks(timer_freq, p_spi_slave_config->timeout_us);
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_ss_poll_period =
+        fs_etpu_spi_us_to_ticks(timer_freq, p_spi_slave_config->ss_poll_period_us);
     
-    /* function mode */
-    if (p_spi_slave_config->clock_phase == 1)
+    /* SS channels / virtual devices - channel numbers are engine relative */
+    /* packed 6 bits per device, 0x3f marks an unused entry */
+    ss_chan_pack = 0;
+    for (i = 0; i < FS_ETPU_SPI_SLAVE_MAX_SS_CNT; i++)
+    {
+        ss_chan_pack |= (uint32_t)((i < ss_cnt) ?
+            (fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i) & 0x1f) : 0x3f) << (6 * i);
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_ss_chan_pack = ss_chan_pack;
+    /* the per device data registers live in a DATA RAM buffer, only needed
+       with more than one device */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_slave_instance->em, &p_spi_slave_instance->dev_buffer_pse,
+        &p_spi_slave_instance->dev_buffer_bytes,
+        (ss_cnt > 1) ? ss_cnt * sizeof(struct spi_slave_dev_entry_pse_t) : 0);
+    if (err_code != 0)
+    {
+        fs_etpu_spi_slave_release(p_spi_slave_instance);
+        return err_code;
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_dev_buf =
+        fs_etpu_spi_pse_addr(p_spi_slave_instance->dev_buffer_pse);
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_ss_cnt = ss_cnt;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_ss_index = 0;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_data_in_index = 0;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_rx_full = 0;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_tx_fresh = 1; /* the initial data out */
+
+    /* SCLK edge checks and statistics */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_slave_instance->em, &p_spi_slave_instance->edge_pse,
+        &p_spi_slave_instance->edge_bytes,
+        ((p_spi_slave_config->min_edge_ticks != 0) || (p_spi_slave_config->sclk_period_enable != 0)) ?
+            sizeof(struct spi_slave_edge_pse_t) : 0);
+    if (err_code != 0)
+    {
+        fs_etpu_spi_slave_release(p_spi_slave_instance);
+        return err_code;
+    }
+    if (p_spi_slave_instance->edge_pse != 0)
+    {
+        struct spi_slave_edge_pse_t *p_edge;
+
+        p_edge = (struct spi_slave_edge_pse_t*)p_spi_slave_instance->edge_pse;
+        fs_memset32_ext((uint32_t*)p_edge, 0, sizeof(struct spi_slave_edge_pse_t));
+        p_edge->min_spacing = p_spi_slave_config->min_edge_ticks;
+        p_edge->stats = p_spi_slave_config->sclk_period_enable;
+        p_edge->restart = 1;
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_edge =
+        fs_etpu_spi_pse_addr(p_spi_slave_instance->edge_pse);
+
+    /* CRC */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_slave_instance->em, &p_spi_slave_instance->crc_pse,
+        &p_spi_slave_instance->crc_bytes,
+        (p_spi_slave_config->crc_size == 0) ? 0 : sizeof(struct spi_slave_crc_pse_t));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_slave_release(p_spi_slave_instance);
+        return err_code;
+    }
+    if (p_spi_slave_instance->crc_pse != 0)
+    {
+        struct spi_slave_crc_pse_t *p_crc;
+
+        p_crc = (struct spi_slave_crc_pse_t*)p_spi_slave_instance->crc_pse;
+        p_crc->poly = FS_ETPU_SPI_CRC_ALIGN(p_spi_slave_config->crc_polynomial, p_spi_slave_config->crc_size);
+        p_crc->init = FS_ETPU_SPI_CRC_ALIGN(p_spi_slave_config->crc_init, p_spi_slave_config->crc_size);
+        p_crc->xorout = FS_ETPU_SPI_CRC_ALIGN(p_spi_slave_config->crc_xorout, p_spi_slave_config->crc_size);
+        p_crc->residue = fs_etpu_spi_crc_residue(p_spi_slave_config->crc_size,
+            p_spi_slave_config->crc_polynomial, p_spi_slave_config->crc_xorout);
+        p_crc->bit_count = p_spi_slave_config->crc_size;
+        p_crc->error = 0;
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_crc =
+        fs_etpu_spi_pse_addr(p_spi_slave_instance->crc_pse);
+    
+    /* DDR / single edge - one thread per bit */
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_miso_hold = p_spi_slave_config->miso_hold_ticks;
+    if ((p_spi_slave_config->ddr != 0) || (p_spi_slave_config->single_edge == 0))
+    {
+        ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_sample_edge = FS_ETPU_SPI_SLAVE_EDGE_BOTH;
+    }
+    else if (p_spi_slave_config->clock_polarity == p_spi_slave_config->clock_phase)
+    {
+        /* CPOL 0 / CPHA 0 and CPOL 1 / CPHA 1 sample on the rising edge */
+        ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_sample_edge = FS_ETPU_SPI_SLAVE_EDGE_RISING;
+    }
+    else
+    {
+        ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_sample_edge = FS_ETPU_SPI_SLAVE_EDGE_FALLING;
+    }
+
+    /* register map - a table of the same size keeps its registers over a re-init */
+    reg_cmd_bits = 0;
+    err_code = fs_etpu_spi_alloc_pse(p_spi_slave_instance->em, &p_spi_slave_instance->reg_table_pse,
+        &p_spi_slave_instance->reg_table_bytes, (p_spi_slave_instance->reg_addr_bit_cnt == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_slave_reg_pse_t, uint32_t, 1 << p_spi_slave_instance->reg_addr_bit_cnt));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_slave_release(p_spi_slave_instance);
+        return err_code;
+    }
+    if (p_spi_slave_instance->reg_table_pse != 0)
+    {
+        reg_cmd_bits = p_spi_slave_instance->reg_addr_bit_cnt + (p_spi_slave_config->reg_write_enable != 0);
+        p_reg = (struct spi_slave_reg_pse_t*)p_spi_slave_instance->reg_table_pse;
+        p_reg->addr_mask = (1 << p_spi_slave_instance->reg_addr_bit_cnt) - 1;
+        p_reg->write_flag = (p_spi_slave_config->reg_write_enable != 0) ? (1 << p_spi_slave_instance->reg_addr_bit_cnt) : 0;
+        /* data bits are left-justified in the table */
+        p_reg->align = 1 << (24 - (p_spi_slave_config->transfer_size - reg_cmd_bits));
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_reg =
+        fs_etpu_spi_pse_addr(p_spi_slave_instance->reg_table_pse);
+
+    /* SS delimited frames */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_slave_instance->em, &p_spi_slave_instance->frame_buffer_pse,
+        &p_spi_slave_instance->frame_buffer_bytes, (p_spi_slave_instance->frame_word_cnt_max == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_slave_frame_pse_t, uint32_t, p_spi_slave_instance->frame_word_cnt_max));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_slave_release(p_spi_slave_instance);
+        return err_code;
+    }
+    if (p_spi_slave_instance->frame_buffer_pse != 0)
+    {
+        ((struct spi_slave_frame_pse_t*)p_spi_slave_instance->frame_buffer_pse)->word_max = p_spi_slave_instance->frame_word_cnt_max;
+        ((struct spi_slave_frame_pse_t*)p_spi_slave_instance->frame_buffer_pse)->word_cnt = 0;
+        ((struct spi_slave_frame_pse_t*)p_spi_slave_instance->frame_buffer_pse)->bit_cnt = 0;
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_frame =
+        fs_etpu_spi_pse_addr(p_spi_slave_instance->frame_buffer_pse);
+
+    /* long words - chained in two segments */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_slave_instance->em, &p_spi_slave_instance->long_pse,
+        &p_spi_slave_instance->long_bytes,
+        (p_spi_slave_config->transfer_size > 24) ? sizeof(struct spi_slave_long_pse_t) : 0);
+    if (err_code != 0)
+    {
+        fs_etpu_spi_slave_release(p_spi_slave_instance);
+        return err_code;
+    }
+    if (p_spi_slave_instance->long_pse != 0)
+    {
+        fs_memset32_ext((uint32_t*)p_spi_slave_instance->long_pse, 0, sizeof(struct spi_slave_long_pse_t));
+        ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_seg_bit_count = p_spi_slave_config->transfer_size - 24;
+    }
+    else
+    {
+        /* the register command ends the first segment */
+        ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_seg_bit_count = reg_cmd_bits;
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_long =
+        fs_etpu_spi_pse_addr(p_spi_slave_instance->long_pse);
+
+    /* counters, cleared here as the channels are stopped */
+    err_code = fs_etpu_spi_alloc_pse(p_spi_slave_instance->em, &p_spi_slave_instance->counters_pse,
+        &p_spi_slave_instance->counters_bytes,
+        (p_spi_slave_instance->counter_enable == 0) ? 0 : sizeof(struct spi_slave_counters_pse_t));
+    if (err_code != 0)
+    {
+        fs_etpu_spi_slave_release(p_spi_slave_instance);
+        return err_code;
+    }
+    if (p_spi_slave_instance->counters_pse != 0)
+    {
+        fs_memset32_ext((uint32_t*)p_spi_slave_instance->counters_pse, 0, sizeof(struct spi_slave_counters_pse_t));
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_counters =
+        fs_etpu_spi_pse_addr(p_spi_slave_instance->counters_pse);
+
+    /* function mode - the edge tables put the first bit out like CPHA 0 */
+    if ((p_spi_slave_config->clock_phase == 1) && (p_spi_slave_config->ddr == 0) &&
+        (p_spi_slave_config->single_edge == 0))
     {
         mode = FS_ETPU_SPI_SLAVE_CPHA_1_FM0;
     }
@@ -315,16 +1991,18 @@ uint32_t fs_etpu_spi_slave_init(
         mode |= (FS_ETPU_SPI_SLAVE_SHIFT_DIR_MSB_FM1 << 1);
     }
     eTPU->CHAN[p_spi_slave_instance->clock_chan_num].SCR.R = mode;
-    if (p_spi_slave_instance->ss_chan_num != 0xff)
+    /* the first bit of a word is put out from the MISO channel */
+    eTPU->CHAN[p_spi_slave_instance->clock_chan_num - 1].SCR.R = mode;
+    for (i = 0; i < ss_cnt; i++)
     {
-        eTPU->CHAN[p_spi_slave_instance->ss_chan_num].SCR.R = mode;
+        eTPU->CHAN[fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i)].SCR.R = mode;
     }
     
     /* hsr */
     eTPU->CHAN[p_spi_slave_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_SLAVE_INIT_HSR;
-    if (p_spi_slave_instance->ss_chan_num != 0xff)
+    for (i = 0; i < ss_cnt; i++)
     {
-        eTPU->CHAN[p_spi_slave_instance->ss_chan_num].HSRR.R = FS_ETPU_SPI_SLAVE_INIT_SS_HSR;
+        eTPU->CHAN[fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i)].HSRR.R = FS_ETPU_SPI_SLAVE_INIT_SS_HSR;
     }
     
     /* final channel configuration */
@@ -335,19 +2013,20 @@ uint32_t fs_etpu_spi_slave_init(
 
     eTPU->CHAN[p_spi_slave_instance->clock_chan_num].CR.R =
         (p_spi_slave_instance->priority << 28) + 
-        (_ENTRY_TABLE_TYPE_SPI_slave_ << 24) +
-        (_FUNCTION_NUM_SPI_slave_ << 16) + 
+        fs_etpu_spi_slave_function(p_spi_slave_config) +
         (uint32_t) (((uint32_t)p_spi_slave_instance->cpba & 0x3fff) >> 3);
         
-    if (p_spi_slave_instance->ss_chan_num != 0xff)
+    for (i = 0; i < ss_cnt; i++)
     {
-        eTPU->CHAN[p_spi_slave_instance->ss_chan_num].CR.R =
+        eTPU->CHAN[fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i)].CR.R =
             (p_spi_slave_instance->priority << 28) + 
-            (_ENTRY_TABLE_TYPE_SPI_slave_ << 24) +
-            (_FUNCTION_NUM_SPI_slave_ << 16) + 
+            fs_etpu_spi_slave_function(p_spi_slave_config) +
             (uint32_t) (((uint32_t)p_spi_slave_instance->cpba & 0x3fff) >> 3);
     }
 
+    ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_attach_sum =
+        fs_etpu_spi_slave_attach_sum(p_spi_slave_instance);
+
     return 0;
 }
 
@@ -357,6 +2036,7 @@ uint32_t fs_etpu_spi_slave_set_data(
     uint32_t data)
 {
     volatile struct eTPU_struct * eTPU;
+    uint8_t lead_bits;
 
     if (p_spi_slave_instance->em == EM_AB)
     {
@@ -367,13 +2047,30 @@ uint32_t fs_etpu_spi_slave_set_data(
         eTPU = eTPU_C;
     }
 
-    /* pre-shift the data if necessary */
-    if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+    if (p_spi_slave_config->transfer_size > 24)
+    {
+        /* long word - the leading segment, then the last 24 bits */
+        lead_bits = p_spi_slave_config->transfer_size - 24;
+        if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+        {
+            ((struct spi_slave_long_pse_t*)p_spi_slave_instance->long_pse)->data_out_lead =
+                (data >> 24) << (24 - lead_bits);
+            data &= 0xffffff;
+        }
+        else
+        {
+            ((struct spi_slave_long_pse_t*)p_spi_slave_instance->long_pse)->data_out_lead =
+                data & ((1 << lead_bits) - 1);
+            data = (data >> lead_bits) & 0xffffff;
+        }
+    }
+    else if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
     {
         /* MSB first, need to shift to the top */
         data <<= (24 - p_spi_slave_config->transfer_size);
     }
     ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_data_out_reg = data;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_tx_fresh = 1;
     eTPU->CHAN[p_spi_slave_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_SLAVE_SET_DATA_HSR;
 
     return 0;
@@ -383,22 +2080,412 @@ uint32_t fs_etpu_spi_slave_get_data(
     struct spi_slave_instance_t *p_spi_slave_instance,
     struct spi_slave_config_t   *p_spi_slave_config,
     uint32_t *p_data)
+{
+    uint32_t data, lead, mask;
+    uint8_t lead_bits;
+
+    data = ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_data_in_reg;
+    if (p_spi_slave_config->transfer_size > 24)
+    {
+        /* long word - join the leading segment to the last 24 bits */
+        lead_bits = p_spi_slave_config->transfer_size - 24;
+        lead = ((struct spi_slave_long_pse_t*)p_spi_slave_instance->long_pse)->data_in_lead & 0xffffff;
+        data &= 0xffffff;
+        if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+        {
+            *p_data = ((lead & ((1 << lead_bits) - 1)) << 24) | data;
+        }
+        else
+        {
+            *p_data = (lead >> (24 - lead_bits)) | (data << lead_bits);
+        }
+    }
+    else
+    {
+        mask = (1 << p_spi_slave_config->transfer_size) - 1;
+        /* shift data to correct bits if necessary */
+        if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            /* LSB first, need to shift down into position */
+            data >>= (24 - p_spi_slave_config->transfer_size);
+        }
+        *p_data = data & mask;
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_get_crc_error(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    uint8_t *p_crc_error)
+{
+    if (p_spi_slave_instance->crc_pse == 0)
+    {
+        *p_crc_error = 0;
+    }
+    else
+    {
+        struct spi_slave_crc_pse_t *p_crc = (struct spi_slave_crc_pse_t*)p_spi_slave_instance->crc_pse;
+
+        /* the eTPU only sets the error, it is cleared here once seen */
+        *p_crc_error = p_crc->error & 0xff;
+        if (*p_crc_error != 0)
+        {
+            p_crc->error = 0;
+        }
+    }
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_set_device_data(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  device_index,
+    uint32_t data)
+{
+    /* only kept with more than one SS, one entry per device */
+    if ((p_spi_slave_instance->dev_buffer_pse == 0) ||
+        (device_index >= fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    /* pre-shift the data if necessary */
+    if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_MSB_FIRST)
+    {
+        /* MSB first, need to shift to the top */
+        data <<= (24 - p_spi_slave_config->transfer_size);
+    }
+    /* loaded on the device's next select or word */
+    ((struct spi_slave_dev_entry_pse_t*)p_spi_slave_instance->dev_buffer_pse)[device_index].data_out = data;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_tx_fresh = 1;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_get_device_data(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  device_index,
+    uint32_t *p_data)
 {
     uint32_t data;
     uint32_t mask = (1 << p_spi_slave_config->transfer_size) - 1;
 
-    data = ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_data_in_reg;
+    /* only kept with more than one SS, one entry per device */
+    if ((p_spi_slave_instance->dev_buffer_pse == 0) ||
+        (device_index >= fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    data = ((struct spi_slave_dev_entry_pse_t*)p_spi_slave_instance->dev_buffer_pse)[device_index].data_in;
     /* shift data to correct bits if necessary */
     if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
     {
         /* LSB first, need to shift down into position */
-        data >>= (24 - p_spi_slave_config->transfer_size);
+        data = (data & 0xffffff) >> (24 - p_spi_slave_config->transfer_size);
     }
     *p_data = data & mask;
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_get_data_index(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    uint8_t *p_device_index)
+{
+    *p_device_index = ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_data_in_index;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_get_frame(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint32_t *p_data,
+    uint32_t *p_bit_cnt)
+{
+    uint32_t bit_cnt, data, word_bits;
+    uint16_t i;
+
+    if (p_spi_slave_instance->frame_buffer_pse == 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+
+    bit_cnt = ((struct spi_slave_frame_pse_t*)p_spi_slave_instance->frame_buffer_pse)->bit_cnt & 0xffffff;
+    *p_bit_cnt = bit_cnt;
+    for (i = 0; (i < p_spi_slave_instance->frame_word_cnt_max) && (bit_cnt != 0); i++)
+    {
+        /* the last word may be a part word */
+        word_bits = (bit_cnt < p_spi_slave_config->transfer_size) ? bit_cnt : p_spi_slave_config->transfer_size;
+        bit_cnt -= word_bits;
+        data = ((struct spi_slave_frame_pse_t*)p_spi_slave_instance->frame_buffer_pse)->buf[i];
+        if (p_spi_slave_config->shift_direction == FS_ETPU_SPI_LSB_FIRST)
+        {
+            /* LSB first, need to shift down into position */
+            data >>= (24 - word_bits);
+        }
+        p_data[i] = data & ((1 << word_bits) - 1);
+    }
+    ((etpu_if_SPI_slave_CHANNEL_FRAME*)p_spi_slave_instance->cpba)->_rx_full = 0;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_set_register(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  addr,
+    uint32_t data)
+{
+    uint8_t data_bits;
+
+    if ((p_spi_slave_instance->reg_table_pse == 0) ||
+        (addr >= (1 << p_spi_slave_instance->reg_addr_bit_cnt)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    data_bits = p_spi_slave_config->transfer_size - p_spi_slave_instance->reg_addr_bit_cnt -
+        (p_spi_slave_config->reg_write_enable != 0);
+    /* left-justified, ready to shift out MSB first */
+    ((struct spi_slave_reg_pse_t*)p_spi_slave_instance->reg_table_pse)->table[addr] = (data << (24 - data_bits)) & 0xffffff;
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_get_register(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  addr,
+    uint32_t *p_data)
+{
+    uint8_t data_bits;
+
+    if ((p_spi_slave_instance->reg_table_pse == 0) ||
+        (addr >= (1 << p_spi_slave_instance->reg_addr_bit_cnt)))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    data_bits = p_spi_slave_config->transfer_size - p_spi_slave_instance->reg_addr_bit_cnt -
+        (p_spi_slave_config->reg_write_enable != 0);
+    *p_data = (((struct spi_slave_reg_pse_t*)p_spi_slave_instance->reg_table_pse)->table[addr] & 0xffffff) >> (24 - data_bits);
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_get_sclk_period(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    struct spi_sclk_period_t    *p_period,
+    uint8_t restart)
+{
+    struct spi_slave_edge_pse_t *p_edge;
+    uint32_t edges;
+
+    if ((p_spi_slave_instance->edge_pse == 0) || (p_spi_slave_config->sclk_period_enable == 0))
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    p_edge = (struct spi_slave_edge_pse_t*)p_spi_slave_instance->edge_pse;
+    if ((p_edge->restart & 0xffffff) != 0)
+    {
+        p_period->period_min = 0;
+        p_period->period_max = 0;
+        p_period->period_avg = 0;
+        p_period->edge_min = 0;
+    }
+    else
+    {
+        /* the eTPU measures edge to edge, an SCLK period is two edges unless
+           only the sampling edge is detected */
+        edges = ((p_spi_slave_config->ddr == 0) && (p_spi_slave_config->single_edge != 0)) ? 1 : 2;
+        p_period->edge_min = p_edge->min & 0xffffff;
+        p_period->period_min = p_period->edge_min * edges;
+        p_period->period_max = (p_edge->max & 0xffffff) * edges;
+        p_period->period_avg = (p_edge->avg & 0xffffff) * edges;
+    }
+    if (restart != 0)
+    {
+        p_edge->restart = 1;
+    }
+
+    return 0;
+}
+
+uint32_t fs_etpu_spi_slave_get_counters(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_counters_t       *p_counters)
+{
+    volatile struct eTPU_struct * eTPU;
+    struct spi_slave_counters_pse_t *p_cnt;
+
+    if (p_spi_slave_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    if (p_spi_slave_instance->counters_pse == 0)
+    {
+        return (FS_ETPU_ERROR_VALUE);
+    }
+    p_cnt = (struct spi_slave_counters_pse_t*)p_spi_slave_instance->counters_pse;
+
+    /* the snapshot HSR must not overwrite a pending request */
+    if (fs_etpu_get_hsr_ext(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num) != 0)
+    {
+        return (FS_ETPU_ERROR_TIMING);
+    }
+    /* the eTPU copies and clears the counters in one thread */
+    eTPU->CHAN[p_spi_slave_instance->clock_chan_num].HSRR.R = FS_ETPU_SPI_SLAVE_COUNTERS_HSR;
+    if (fs_etpu_spi_wait_hsr(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num) != 0)
+    {
+        return (FS_ETPU_ERROR_TIMING);
+    }
+
+    p_counters->rx_overrun_cnt = p_cnt->snap_rx_overrun_cnt & 0xffffff;
+    p_counters->tx_underrun_cnt = p_cnt->snap_tx_underrun_cnt & 0xffffff;
+    p_counters->timeout_cnt = p_cnt->snap_timeout_cnt & 0xffffff;
+    p_counters->abort_cnt = p_cnt->snap_abort_cnt & 0xffffff;
+    p_counters->error_cnt = p_cnt->snap_error_cnt & 0xffffff;
+    p_counters->glitch_cnt = p_cnt->snap_glitch_cnt & 0xffffff;
 
     return 0;
 }
 
+uint32_t fs_etpu_spi_slave_deinit(
+    struct spi_slave_instance_t *p_spi_slave_instance)
+{
+    uint8_t ss_cnt;
+    int32_t i;
+
+    ss_cnt = fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance);
+
+    /* a pending init must not run on released memory */
+    if (fs_etpu_get_hsr_ext(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num) != 0)
+    {
+        return (FS_ETPU_ERROR_TIMING);
+    }
+    for (i = 0; i < ss_cnt; i++)
+    {
+        if (fs_etpu_get_hsr_ext(p_spi_slave_instance->em, fs_etpu_spi_slave_ss_chan(p_spi_slave_instance, i)) != 0)
+        {
+            return (FS_ETPU_ERROR_TIMING);
+        }
+    }
+
+    return fs_etpu_spi_slave_release(p_spi_slave_instance);
+}
+
+uint32_t fs_etpu_spi_slave_reattach(
+    struct spi_slave_instance_t *p_spi_slave_instance)
+{
+    volatile struct eTPU_struct * eTPU;
+    uint32_t err_code = 0;
+    uint8_t ss_cnt;
+
+    if (p_spi_slave_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+    if (eTPU->CHAN[p_spi_slave_instance->clock_chan_num].CR.B.CPBA == 0)
+    {
+        return (FS_ETPU_ERROR_ADDRESS);
+    }
+    p_spi_slave_instance->cpba = fs_etpu_get_cpba_ext(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num);
+    p_spi_slave_instance->cpba_pse = fs_etpu_get_cpba_pse_ext(p_spi_slave_instance->em, p_spi_slave_instance->clock_chan_num);
+
+    /* the buffers are where the running frame points */
+    ss_cnt = fs_etpu_spi_slave_ss_cnt(p_spi_slave_instance);
+    p_spi_slave_instance->reg_table_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_reg,
+        p_spi_slave_instance->reg_addr_bit_cnt);
+    p_spi_slave_instance->frame_buffer_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_frame,
+        p_spi_slave_instance->frame_word_cnt_max);
+    p_spi_slave_instance->dev_buffer_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_dev_buf,
+        ss_cnt > 1);
+    /* the optional blocks exist when the frame points to them */
+    p_spi_slave_instance->crc_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_crc,
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_crc & 0xffffff);
+    p_spi_slave_instance->long_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_long,
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_long & 0xffffff);
+    p_spi_slave_instance->edge_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_edge,
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_edge & 0xffffff);
+    p_spi_slave_instance->counters_pse = fs_etpu_spi_addr_pse(
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_counters,
+        ((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_counters & 0xffffff);
+
+    if (fs_etpu_spi_slave_attach_sum(p_spi_slave_instance) !=
+        (((etpu_if_SPI_slave_CHANNEL_FRAME_PSE*)p_spi_slave_instance->cpba_pse)->_attach_sum & 0xffffff))
+    {
+        /* not the frame of this instance - it needs a cold init */
+        p_spi_slave_instance->cpba = 0;
+        p_spi_slave_instance->cpba_pse = 0;
+        p_spi_slave_instance->reg_table_pse = 0;
+        p_spi_slave_instance->frame_buffer_pse = 0;
+        p_spi_slave_instance->dev_buffer_pse = 0;
+        p_spi_slave_instance->crc_pse = 0;
+        p_spi_slave_instance->long_pse = 0;
+        p_spi_slave_instance->edge_pse = 0;
+        p_spi_slave_instance->counters_pse = 0;
+        return (FS_ETPU_ERROR_CHECKSUM);
+    }
+
+    /* the checksum holds the counts the buffers were sized by at init */
+    p_spi_slave_instance->dev_buffer_bytes = (p_spi_slave_instance->dev_buffer_pse == 0) ? 0 :
+        ss_cnt * sizeof(struct spi_slave_dev_entry_pse_t);
+    p_spi_slave_instance->edge_bytes = (p_spi_slave_instance->edge_pse == 0) ? 0 :
+        sizeof(struct spi_slave_edge_pse_t);
+    p_spi_slave_instance->crc_bytes = (p_spi_slave_instance->crc_pse == 0) ? 0 :
+        sizeof(struct spi_slave_crc_pse_t);
+    p_spi_slave_instance->reg_table_bytes = (p_spi_slave_instance->reg_table_pse == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_slave_reg_pse_t, uint32_t, 1 << p_spi_slave_instance->reg_addr_bit_cnt);
+    p_spi_slave_instance->frame_buffer_bytes = (p_spi_slave_instance->frame_buffer_pse == 0) ? 0 :
+        FS_ETPU_SPI_BLOCK_SIZE(struct spi_slave_frame_pse_t, uint32_t, p_spi_slave_instance->frame_word_cnt_max);
+    p_spi_slave_instance->long_bytes = (p_spi_slave_instance->long_pse == 0) ? 0 :
+        sizeof(struct spi_slave_long_pse_t);
+    p_spi_slave_instance->counters_bytes = (p_spi_slave_instance->counters_pse == 0) ? 0 :
+        sizeof(struct spi_slave_counters_pse_t);
+
+    /* the allocator takes the memory back */
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->cpba_pse,
+        _FRAME_SIZE_SPI_slave_, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->dev_buffer_pse,
+        p_spi_slave_instance->dev_buffer_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->edge_pse,
+        p_spi_slave_instance->edge_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->crc_pse,
+        p_spi_slave_instance->crc_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->reg_table_pse,
+        p_spi_slave_instance->reg_table_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->frame_buffer_pse,
+        p_spi_slave_instance->frame_buffer_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->long_pse,
+        p_spi_slave_instance->long_bytes, &err_code);
+    fs_etpu_spi_claim_pse(p_spi_slave_instance->em, p_spi_slave_instance->counters_pse,
+        p_spi_slave_instance->counters_bytes, &err_code);
+
+    return err_code;
+}
+
 
 /*********************************************************************
  *
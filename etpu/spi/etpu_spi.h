@@ -15,6 +15,10 @@ extern "C" {
 #endif
 
 #define FS_ETPU_SPI_MASTER_MAX_SLAVE_SELECT_CNT 4
+#define FS_ETPU_SPI_MASTER_MAX_SS_DECODER_ADDR_BIT_CNT 5
+#define FS_ETPU_SPI_SLAVE_MAX_REG_ADDR_BIT_CNT 8
+#define FS_ETPU_SPI_SLAVE_MAX_TRANSFER_SIZE 32 /* over 24 -> two segments in the eTPU */
+#define FS_ETPU_SPI_SLAVE_MAX_SS_CNT 4 /* must match SPI_SLAVE_MAX_SS_CNT in etec_spi_slave.c */
 
 #define FS_ETPU_SPI_MSB_FIRST   0
 #define FS_ETPU_SPI_LSB_FIRST   1
@@ -41,17 +45,76 @@ SS channel(s) [optional, same engine]
 * Type Definitions
 *******************************************************************************/
 
+/** A structure to represent one entry of a SPI_master angle schedule
+ *  (e.g. one per cylinder).  A transfer is started when TCR2 (angle mode)
+ *  reaches the entry angle; the entries are used in turn. */
+struct spi_master_angle_entry_t
+{
+    uint32_t      angle; /* TCR2 angle count at which to start the transfer */
+    uint32_t      data;  /* data to transmit */
+    int8_t        slave_select_index; /* -1 indicates no ss, decoder address in decoder mode */
+};
+
+/** A structure to hold one snapshot of the SPI error counters.  Each
+ *  counter covers the interval since the previous snapshot and saturates
+ *  at 0xffffff (eTPU 24-bit counters).  The counters are only kept when
+ *  the instance counter_enable is set. */
+struct spi_counters_t
+{
+    uint32_t      rx_overrun_cnt;  /* words (stream half rings) received before the last was read */
+    uint32_t      tx_underrun_cnt; /* words (stream half rings) sent without new data */
+    uint32_t      timeout_cnt;     /* slave only - words abandoned on SCLK timeout */
+    uint32_t      abort_cnt;       /* slave only - words cut short by SS deselect */
+    uint32_t      error_cnt;       /* unexpected eTPU entries */
+    uint32_t      glitch_cnt;      /* slave only - words (frames) dropped on a too close SCLK edge */
+};
+
+/** A structure to hold the SCLK period seen by SPI_slave, in timer counts,
+ *  since initialization or the last restart.  0 -> no edge measured yet. */
+struct spi_sclk_period_t
+{
+    uint32_t      period_min;
+    uint32_t      period_max;
+    uint32_t      period_avg;      /* running average, recent bits weigh most */
+    uint32_t      edge_min;        /* shortest edge to edge time - the slave service limit */
+};
+
 /** A structure to represent an instance of SPI_master
  *  It includes static SPI_master initialization items. */
 struct spi_master_instance_t
 {
     ETPU_MODULE   em;
     uint8_t       clock_chan_num;
-    /* slave select channels should be set to 0xff to disable */
+    /* slave select channels should be set to 0xff to disable - they are driven
+       by match pin actions from the clock channel thread, no function is assigned */
     uint8_t       slave_select_chan_list[FS_ETPU_SPI_MASTER_MAX_SLAVE_SELECT_CNT];
+                  /* in decoder mode, entry 0 is the (active low) decoder enable */
     uint8_t       priority;
     void          *cpba;        /* set during initialization */
     void          *cpba_pse;    /* set during initialization */
+    /* angle mode [optional] - transfers are started on TCR2 angle targets rather
+       than by fs_etpu_spi_master_transmit_data, clocking is on TCR1 */
+    struct spi_master_angle_entry_t *angle_table; /* set to 0 to disable */
+    uint8_t       angle_entry_cnt;
+    void          *angle_table_pse; /* set during initialization */
+    uint16_t      angle_table_bytes; /* set during initialization */
+    uint8_t       burst_word_cnt_max; /* 0 -> no burst read support */
+    void          *burst_buffer_pse; /* set during initialization */
+    uint16_t      burst_buffer_bytes; /* set during initialization */
+    uint8_t       ss_decoder_addr_bit_cnt; /* 0 -> slave select list, else 3 or 5 */
+    uint8_t       ss_decoder_addr_chan; /* decoder address LSB, further bits on following channels */
+    uint8_t       chain_word_cnt_max; /* 0 -> no daisy chain support */
+    void          *chain_buffer_pse; /* set during initialization */
+    uint16_t      chain_buffer_bytes; /* set during initialization */
+    uint8_t       latch_chan; /* daisy chain latch output, used if latch_width_us != 0 */
+    uint16_t      stream_word_cnt; /* 0 -> no streaming support, else even ring size */
+    void          *stream_buffer_pse; /* set during initialization */
+    uint16_t      stream_buffer_bytes; /* set during initialization */
+    void          *crc_pse; /* set during initialization */
+    uint16_t      crc_bytes; /* set during initialization */
+    uint8_t       counter_enable; /* 0 -> no error counters */
+    void          *counters_pse; /* set during initialization */
+    uint16_t      counters_bytes; /* set during initialization */
 };
 /** A structure to represent a configuration of SPI_master.
  *  It includes SPI_master configuration items which can be changed in run-time. */
@@ -66,6 +129,27 @@ struct spi_master_config_t
     uint32_t      slave_select_delay_us; /* if slave select (ss) is used, this is 
                     the time (us) between the ss output gettign set active (low) and the
                     first clock pulse - should be set to at least half a bit time. */
+    /* CRC [optional, MSB first only] - crc_size CRC bits are appended to each transmitted
+       word and checked on each received word, a mismatch sets the CRC error read by
+       fs_etpu_spi_master_get_crc_error, before the channel interrupt of the transfer */
+    uint8_t       crc_size; /* 0 -> no CRC, else 1 to 24 bits (e.g. 8 or 16) */
+    uint32_t      crc_polynomial; /* e.g. 0x1d for CRC-8 SAE J1850, 0x1021 for CRC-16 CCITT */
+    uint32_t      crc_init; /* e.g. 0xff for CRC-8 SAE J1850, 0xffff for CRC-16 CCITT */
+    uint32_t      crc_xorout; /* e.g. 0xff for CRC-8 SAE J1850, 0 for CRC-16 CCITT */
+    uint32_t      latch_width_us; /* 0 -> no latch pulse after a daisy chain transfer */
+    uint8_t       latch_polarity; /* latch idle level, 0 -> high going pulse */
+    uint32_t      chain_refresh_period_us; /* daisy chain refresh period, start to start */
+    uint32_t      miso_sample_delay_ticks; /* 0 -> sample MISO on the clock edge, else
+                    sample this many timer counts after it - must be under half a bit time;
+                    the pin is read when the eTPU services the sample, so delay plus the
+                    worst case eTPU service latency must stay within the MISO valid time */
+    /* DDR [optional, eTPU to eTPU links only] - a bit on both clock edges, MOSI changes
+       a quarter bit after each edge; clock_phase is ignored, transfer_size must be even,
+       no CRC, burst, daisy chain or MISO sample delay */
+    uint8_t       ddr; /* 0 -> standard SPI, 1 -> double data rate */
+    /* streaming [optional] - the slave select is a frame sync, active for the
+       first word of each frame */
+    uint8_t       stream_frame_word_cnt; /* words per frame, at least 2 (2 for I2S) */
 };
 
 /** A structure to represent an instance of SPI_slave
@@ -78,6 +162,30 @@ struct spi_slave_instance_t
     uint8_t       priority;
     void          *cpba;        /* set during initialization */
     void          *cpba_pse;    /* set during initialization */
+    /* register map [optional] - see spi_slave_config_t */
+    uint8_t       reg_addr_bit_cnt; /* 0 -> no register map, else 1 to 8 (2^n registers) */
+    void          *reg_table_pse; /* set during initialization */
+    uint16_t      reg_table_bytes; /* set during initialization */
+    /* frames [optional, SS and no CRC required] - words received while SS is held
+       active are buffered, a single interrupt (from the SS channel) ends the frame */
+    uint16_t      frame_word_cnt_max; /* 0 -> an interrupt per word, else buffer size */
+    void          *frame_buffer_pse; /* set during initialization */
+    uint16_t      frame_buffer_bytes; /* set during initialization */
+    /* virtual devices [optional] - further SS inputs sharing SCLK, MOSI and MISO, each
+       a device with its own data registers (ss_chan_num is device 0) */
+    uint8_t       ss_device_cnt; /* 0 or 1 -> ss_chan_num only, else 2 to 4 devices */
+    uint8_t       ss_device_chan_list[FS_ETPU_SPI_SLAVE_MAX_SS_CNT - 1]; /* SS of devices 1 to ss_device_cnt - 1 */
+    void          *dev_buffer_pse; /* set during initialization */
+    uint16_t      dev_buffer_bytes; /* set during initialization */
+    void          *crc_pse; /* set during initialization */
+    uint16_t      crc_bytes; /* set during initialization */
+    void          *long_pse; /* set during initialization */
+    uint16_t      long_bytes; /* set during initialization */
+    void          *edge_pse; /* set during initialization */
+    uint16_t      edge_bytes; /* set during initialization */
+    uint8_t       counter_enable; /* 0 -> no error counters */
+    void          *counters_pse; /* set during initialization */
+    uint16_t      counters_bytes; /* set during initialization */
 };
 /** A structure to represent a configuration of SPI_slave.
  *  It includes SPI_slave configuration items which can be changed in run-time. */
@@ -87,10 +195,42 @@ struct spi_slave_config_t
     uint8_t       clock_polarity; /* standard CPOL 0 or 1 setting */
     uint8_t       clock_phase;    /* standard CPHA 0 ir 1 setting */
     uint8_t       shift_direction; /* 0 -> MSB first, 1 -> LSB first */
-    uint8_t       transfer_size; /* 1 to 24 bits */
-    uint32_t      timeout_us; /* if a transfer starts, but doesn't complete, after
-                    this amount of time (us), the slave SPI re-initializes itself to prepare
-                    for another transfer. */
+    uint8_t       transfer_size; /* 1 to 32 bits - over 24 bits, no CRC, register map,
+                    frames or virtual devices */
+    uint32_t      timeout_us; /* if a word starts, but doesn't complete (CRC included)
+                    within this amount of time (us) of its first bit, the slave SPI
+                    re-initializes itself to prepare for another transfer - must exceed
+                    the longest word time. */
+    /* CRC [optional, MSB first only] - crc_size CRC bits follow each data word in both
+       directions, a mismatch on a received word sets the CRC error read by
+       fs_etpu_spi_slave_get_crc_error, before the channel interrupt of the word */
+    uint8_t       crc_size; /* 0 -> no CRC, else 1 to 24 bits (e.g. 8 or 16) */
+    uint32_t      crc_polynomial; /* e.g. 0x1d for CRC-8 SAE J1850, 0x1021 for CRC-16 CCITT */
+    uint32_t      crc_init; /* e.g. 0xff for CRC-8 SAE J1850, 0xffff for CRC-16 CCITT */
+    uint32_t      crc_xorout; /* e.g. 0xff for CRC-8 SAE J1850, 0 for CRC-16 CCITT */
+    /* DDR [optional, eTPU to eTPU links only] - see spi_master_config_t, no CRC */
+    uint8_t       ddr; /* 0 -> standard SPI, 1 -> double data rate */
+    /* Single edge [optional, no CRC] - only the sampling edge is detected and the next
+       MISO bit is put out in the same thread, halving the slave thread count */
+    uint8_t       single_edge; /* 0 -> both edges serviced, 1 -> sampling edge only */
+    uint32_t      miso_hold_ticks; /* DDR / single edge: MISO changes this many timer counts
+                    after the captured edge - must exceed the master service latency and be
+                    under half a bit time (0 -> immediately, when the master latches MISO
+                    in hardware) */
+    /* SS level polling [optional] - the SS input is serviced on its transitions;
+       a rare level check only guards against a missed transition */
+    uint32_t      ss_poll_period_us; /* 0 -> no polling, else e.g. 100000 */
+    /* register map [MSB first, no CRC, used if reg_addr_bit_cnt != 0] - each word
+       starts with a command of reg_addr_bit_cnt address bits, preceded by a write
+       flag bit if enabled, and the addressed register is shifted out as the rest
+       of the same word (transfer_size - command bits) */
+    uint8_t       reg_write_enable; /* 0 -> read only, 1 -> a set write flag stores the data in */
+    /* glitch check [optional] - an SCLK edge closer than this to the previous one
+       within a word drops the word (with SS, the rest of the select) and counts a glitch */
+    uint32_t      min_edge_ticks; /* 0 -> no check, else under the shortest edge to edge time */
+    /* SCLK period [optional] - edge to edge statistics for get_sclk_period, kept
+       on every serviced clock edge */
+    uint8_t       sclk_period_enable; /* 0 -> no statistics, 1 -> kept */
 };
 
 /* SPI master interfaces */
@@ -110,6 +250,95 @@ uint32_t fs_etpu_spi_master_get_data(
     struct spi_master_config_t   *p_spi_master_config,
     uint32_t *p_data);
 
+uint32_t fs_etpu_spi_master_get_crc_error(
+    struct spi_master_instance_t *p_spi_master_instance,
+    uint8_t *p_crc_error); /* 1 -> a word failed its CRC since the last read, read and reset */
+
+uint32_t fs_etpu_spi_master_set_angle_entry(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint8_t entry_index);
+
+uint32_t fs_etpu_spi_master_get_angle_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint8_t entry_index,
+    uint32_t *p_data);
+
+uint32_t fs_etpu_spi_master_burst_read(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t command,
+    uint8_t command_size, /* 1 to 24 bits */
+    uint32_t dummy_data, /* transmitted during each response word */
+    uint8_t word_cnt,
+    int8_t slave_select_index); /* -1 indicates no ss */
+
+uint32_t fs_etpu_spi_master_get_burst_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint8_t word_cnt);
+
+uint32_t fs_etpu_spi_master_chain_transmit(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data, /* p_data[0] is shifted first, to the far end of the chain */
+    uint8_t word_cnt,
+    int8_t slave_select_index, /* -1 indicates no ss */
+    uint8_t refresh); /* 1 -> repeat every chain_refresh_period_us */
+
+uint32_t fs_etpu_spi_master_set_chain_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint8_t word_cnt);
+
+uint32_t fs_etpu_spi_master_get_chain_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint8_t word_cnt);
+
+uint32_t fs_etpu_spi_master_chain_stop(
+    struct spi_master_instance_t *p_spi_master_instance);
+
+uint32_t fs_etpu_spi_master_stream_start(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    int8_t frame_sync_index); /* slave select used as frame sync, -1 indicates none */
+
+uint32_t fs_etpu_spi_master_set_stream_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint16_t first_index,
+    uint16_t word_cnt);
+
+uint32_t fs_etpu_spi_master_get_stream_data(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_master_config_t   *p_spi_master_config,
+    uint32_t *p_data,
+    uint16_t first_index,
+    uint16_t word_cnt);
+
+uint32_t fs_etpu_spi_master_get_stream_index(
+    struct spi_master_instance_t *p_spi_master_instance,
+    uint16_t *p_index); /* ring index of the word being transferred */
+
+uint32_t fs_etpu_spi_master_stream_stop(
+    struct spi_master_instance_t *p_spi_master_instance);
+
+uint32_t fs_etpu_spi_master_get_counters(
+    struct spi_master_instance_t *p_spi_master_instance,
+    struct spi_counters_t        *p_counters); /* read and reset */
+
+uint32_t fs_etpu_spi_master_deinit(
+    struct spi_master_instance_t *p_spi_master_instance); /* stops the channels, releases the DATA RAM */
+
+uint32_t fs_etpu_spi_master_reattach(
+    struct spi_master_instance_t *p_spi_master_instance); /* after a host reset - binds to the running frame, no reinit */
+
 
 /* SPI slave interfaces */
 
@@ -127,6 +356,60 @@ uint32_t fs_etpu_spi_slave_get_data(
     struct spi_slave_config_t   *p_spi_slave_config,
     uint32_t *p_data);
 
+uint32_t fs_etpu_spi_slave_get_crc_error(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    uint8_t *p_crc_error); /* 1 -> a word failed its CRC since the last read, read and reset */
+
+uint32_t fs_etpu_spi_slave_set_device_data(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  device_index,
+    uint32_t data);
+
+uint32_t fs_etpu_spi_slave_get_device_data(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  device_index,
+    uint32_t *p_data);
+
+uint32_t fs_etpu_spi_slave_get_data_index(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    uint8_t *p_device_index); /* device of the last word received */
+
+uint32_t fs_etpu_spi_slave_get_frame(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint32_t *p_data, /* room for frame_word_cnt_max words */
+    uint32_t *p_bit_cnt); /* frame length, may exceed the words stored */
+
+uint32_t fs_etpu_spi_slave_set_register(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  addr,
+    uint32_t data);
+
+uint32_t fs_etpu_spi_slave_get_register(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    uint8_t  addr,
+    uint32_t *p_data);
+
+uint32_t fs_etpu_spi_slave_get_sclk_period(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_slave_config_t   *p_spi_slave_config,
+    struct spi_sclk_period_t    *p_period,
+    uint8_t restart); /* 1 -> start a new measurement after this read */
+
+uint32_t fs_etpu_spi_slave_get_counters(
+    struct spi_slave_instance_t *p_spi_slave_instance,
+    struct spi_counters_t       *p_counters); /* read and reset */
+
+uint32_t fs_etpu_spi_slave_deinit(
+    struct spi_slave_instance_t *p_spi_slave_instance); /* stops the channels, releases the DATA RAM */
+
+uint32_t fs_etpu_spi_slave_reattach(
+    struct spi_slave_instance_t *p_spi_slave_instance); /* after a host reset - binds to the running frame, no reinit */
+
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,9 @@
 * @brief   This file contains a template of eTPU module initialization.
 *          There are 2 functions to be used by the application:
 *          - my_system_etpu_init - initialize eTPU global and channel setting
+*            (my_system_etpu_init_rle - the same from a compressed code image)
+*          - my_system_etpu_warm_init - re-attach to a running eTPU after
+*            a host reset
 *          - my_system_etpu_start - run the eTPU
 *
 *******************************************************************************/
@@ -136,8 +139,29 @@ struct spi_master_instance_t spi_master_1_instance =
     ETPU_SPI_MASTER1_SCLK_CHAN,
     { 0xff, 0xff, 0xff, 0xff, }, /* no slave selects */
     FS_ETPU_PRIORITY_MIDDLE,
-    0,
-    0,
+    0, /* cpba */
+    0, /* cpba_pse */
+    0, /* no angle table */
+    0, /* angle_entry_cnt */
+    0, /* angle_table_pse */
+    0, /* angle_table_bytes */
+    0, /* no burst read */
+    0, /* burst_buffer_pse */
+    0, /* burst_buffer_bytes */
+    0, /* no slave select decoder */
+    0, /* ss_decoder_addr_chan */
+    0, /* no daisy chain */
+    0, /* chain_buffer_pse */
+    0, /* chain_buffer_bytes */
+    0, /* latch_chan */
+    0, /* no streaming */
+    0, /* stream_buffer_pse */
+    0, /* stream_buffer_bytes */
+    0, /* crc_pse */
+    0, /* crc_bytes */
+    0, /* no error counters */
+    0, /* counters_pse */
+    0, /* counters_bytes */
 };
 struct spi_master_config_t spi_master_1_config =
 {
@@ -148,6 +172,16 @@ struct spi_master_config_t spi_master_1_config =
     8,
     100000, /* 100kHz baud rate */
     20,
+    0, /* no CRC */
+    0, /* crc_polynomial */
+    0, /* crc_init */
+    0, /* crc_xorout */
+    0, /* no latch pulse */
+    0, /* latch_polarity */
+    0, /* chain_refresh_period_us */
+    0, /* MISO sampled on the clock edge */
+    0, /* no DDR */
+    0, /* stream_frame_word_cnt */
 };
 
 /*******************************************************************************
@@ -159,8 +193,27 @@ struct spi_slave_instance_t spi_slave_1_instance =
     ETPU_SPI_SLAVE1_SCLK_CHAN,
     0xff, /* no ss input for this instance */
     FS_ETPU_PRIORITY_MIDDLE,
-    0,
-    0,
+    0, /* cpba */
+    0, /* cpba_pse */
+    0, /* no register map */
+    0, /* reg_table_pse */
+    0, /* reg_table_bytes */
+    0, /* an interrupt per word */
+    0, /* frame_buffer_pse */
+    0, /* frame_buffer_bytes */
+    0, /* no virtual devices */
+    { 0xff, 0xff, 0xff, },
+    0, /* dev_buffer_pse */
+    0, /* dev_buffer_bytes */
+    0, /* crc_pse */
+    0, /* crc_bytes */
+    0, /* long_pse */
+    0, /* long_bytes */
+    0, /* edge_pse */
+    0, /* edge_bytes */
+    0, /* no error counters */
+    0, /* counters_pse */
+    0, /* counters_bytes */
 };
 struct spi_slave_config_t spi_slave_1_config =
 {
@@ -170,6 +223,17 @@ struct spi_slave_config_t spi_slave_1_config =
     FS_ETPU_SPI_LSB_FIRST,
     8,
     1000, /* 1ms timeout */
+    0, /* no CRC */
+    0, /* crc_polynomial */
+    0, /* crc_init */
+    0, /* crc_xorout */
+    0, /* no DDR */
+    0, /* both edges serviced */
+    0, /* miso_hold_ticks */
+    0, /* no SS level polling */
+    0, /* register map read only */
+    0, /* no glitch check */
+    0, /* no SCLK period statistics */
 };
 
 #if 0
@@ -214,12 +278,23 @@ struct <func2>_config_t <func2>_config =
 struct <func2>_states_t <func2>_states;
 #endif
 
+/*******************************************************************************
+ * eTPU code image - run-length compressed
+ ******************************************************************************/
+/** @brief   The eTPU code image compressed at build time (etpu_set_scm_rle.h,
+ *           written by etpu_code_rle_gen), and the flash bytes of the images. */
+const uint32_t *const my_etpu_code_rle = (const uint32_t *)etpu_code_rle;
+const uint32_t my_etpu_code_rle_size = sizeof(etpu_code_rle);
+#ifndef FS_ETPU_CODE_RLE_ONLY
+const uint32_t my_etpu_code_size = sizeof(etpu_code);
+#endif
+
 /*******************************************************************************
 * FUNCTION: my_system_etpu_init
 ****************************************************************************//*!
 * @brief   This function initialize the eTPU module:
-*          -# Initialize global setting using fs_etpu_init function
-*             and the my_etpu_config structure
+*          -# Initialize global setting using fs_etpu_init_rle_ext function,
+*             the compressed code image and the my_etpu_config structure
 *          -# On eTPU2, initialize the additional eTPU2 setting using
 *             fs_etpu2_init function
 *          -# Initialize channel setting using channel function APIs
@@ -227,6 +302,27 @@ struct <func2>_states_t <func2>_states;
 * @return  Zero or an error code is returned.
 *******************************************************************************/
 int32_t my_system_etpu_init(void)
+{
+  return(my_system_etpu_init_rle((uint32_t *)my_etpu_code_rle, my_etpu_code_rle_size));
+}
+
+/*******************************************************************************
+* FUNCTION: my_system_etpu_init_rle
+****************************************************************************//*!
+* @brief   This function initialize the eTPU module as my_system_etpu_init,
+*          loading the eTPU code from the given compressed image using
+*          fs_etpu_init_rle_ext.
+*
+* @param   *rle_code - The image (see my_etpu_code_rle), or 0 to load the
+*          raw etpu_code using fs_etpu_init_ext (not with
+*          FS_ETPU_CODE_RLE_ONLY).
+* @param   rle_code_size - The size of the image in bytes.
+*
+* @return  Zero or an error code is returned.
+*******************************************************************************/
+int32_t my_system_etpu_init_rle(
+  uint32_t *rle_code,
+  uint32_t rle_code_size)
 {
   int32_t err_code;
 
@@ -234,11 +330,26 @@ int32_t my_system_etpu_init(void)
   fs_memset32_ext((uint32_t*)fs_etpu_data_ram_start, 0, fs_etpu_data_ram_end - fs_etpu_data_ram_start);
 
   /* Initialization of eTPU global settings */
-  err_code = fs_etpu_init_ext(
-    EM_AB,
-    &my_etpu_config,
-    (uint32_t *)etpu_code, sizeof(etpu_code),
-    (uint32_t *)etpu_globals, sizeof(etpu_globals));
+  if(rle_code != 0)
+  {
+    err_code = fs_etpu_init_rle_ext(
+      EM_AB,
+      &my_etpu_config,
+      rle_code, rle_code_size,
+      (uint32_t *)etpu_globals, sizeof(etpu_globals));
+  }
+  else
+  {
+#ifndef FS_ETPU_CODE_RLE_ONLY
+    err_code = fs_etpu_init_ext(
+      EM_AB,
+      &my_etpu_config,
+      (uint32_t *)etpu_code, sizeof(etpu_code),
+      (uint32_t *)etpu_globals, sizeof(etpu_globals));
+#else
+    err_code = FS_ETPU_ERROR_VALUE;
+#endif
+  }
   if(err_code != 0) return(err_code);
 
 #ifdef FS_ETPU_ARCHITECTURE
@@ -308,6 +419,62 @@ int32_t my_system_etpu_init(void)
   return(0);
 }
 
+/*******************************************************************************
+* FUNCTION: my_system_etpu_warm_init
+****************************************************************************//*!
+* @brief   This function re-attaches to an eTPU module which kept running
+*          through a host reset, instead of my_system_etpu_init:
+*          -# Check the loaded eTPU code, read back against the checksum
+*             of my_etpu_code_rle, and global setting using
+*             fs_etpu_warm_init_ext and the my_etpu_config structure
+*          -# On eTPU2, take the engine memory back using
+*             fs_etpu2_warm_init_ext, outside the heap as at a cold start
+*          -# Re-attach the channel instances to their running frames
+*          Nothing is reloaded or reinitialized, so the channels go on
+*          without interruption.
+* @warning my_etpu_config and the instance structures must be the same as at
+*          the last my_system_etpu_init. On an error, call
+*          my_system_etpu_init for a cold start.
+*
+* @return  Zero or an error code is returned.
+*******************************************************************************/
+int32_t my_system_etpu_warm_init(void)
+{
+  int32_t err_code;
+
+  /* Check of eTPU code, against the checksum of the build, and global settings */
+  err_code = fs_etpu_warm_init_ext(
+    EM_AB,
+    &my_etpu_config,
+    FS_ETPU_CODE_RLE_SIZE(my_etpu_code_rle),
+    FS_ETPU_CODE_RLE_CHECKSUM(my_etpu_code_rle),
+    sizeof(etpu_globals));
+  if(err_code != 0) return(err_code);
+
+#ifdef FS_ETPU_ARCHITECTURE
+ #if FS_ETPU_ARCHITECTURE == ETPU2
+  /* Re-attach of additional eTPU2-only engine memory */
+  err_code = fs_etpu2_warm_init_ext(
+    EM_AB,
+  #ifdef FS_ETPU_ENGINE_MEM_SIZE
+    FS_ETPU_ENGINE_MEM_SIZE);
+  #else
+    0);
+  #endif
+  if(err_code != FS_ETPU_ERROR_NONE) return(err_code);
+ #endif
+#endif
+
+  /* Re-attach of eTPU channel instances */
+  err_code = fs_etpu_spi_master_reattach(&spi_master_1_instance);
+  if(err_code != FS_ETPU_ERROR_NONE) return(err_code + (ETPU_SPI_MASTER1_SCLK_CHAN<<16));
+
+  err_code = fs_etpu_spi_slave_reattach(&spi_slave_1_instance);
+  if(err_code != FS_ETPU_ERROR_NONE) return(err_code + (ETPU_SPI_SLAVE1_SCLK_CHAN<<16));
+
+  return(0);
+}
+
 /*******************************************************************************
 * FUNCTION: my_system_etpu_start
 ****************************************************************************//*!
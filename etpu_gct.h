@@ -49,6 +49,7 @@
 * Define Functions to Channels
 *******************************************************************************/
 #define ETPU_SPI_MASTER1_SS_CHAN    ETPU_ENGINE_A_CHANNEL(1)
+#define ETPU_SPI_MASTER1_SS2_CHAN   ETPU_ENGINE_A_CHANNEL(2)
 #define ETPU_SPI_MASTER1_MISO_CHAN  ETPU_ENGINE_A_CHANNEL(3)
 #define ETPU_SPI_MASTER1_SCLK_CHAN  ETPU_ENGINE_A_CHANNEL(4)
 #define ETPU_SPI_MASTER1_MOSI_CHAN  ETPU_ENGINE_A_CHANNEL(5)
@@ -57,6 +58,7 @@
 #define ETPU_SPI_SLAVE1_MISO_CHAN   ETPU_ENGINE_A_CHANNEL(7)
 #define ETPU_SPI_SLAVE1_SCLK_CHAN   ETPU_ENGINE_A_CHANNEL(8)
 #define ETPU_SPI_SLAVE1_MOSI_CHAN   ETPU_ENGINE_A_CHANNEL(9)
+#define ETPU_SPI_SLAVE1_SS2_CHAN    ETPU_ENGINE_A_CHANNEL(11)
 
 /*******************************************************************************
 * Define Interrupt Enable, DMA Enable and Output Disable
@@ -82,6 +84,13 @@ extern struct spi_master_config_t spi_master_1_config;
 extern struct spi_slave_instance_t spi_slave_1_instance;
 extern struct spi_slave_config_t spi_slave_1_config;
 
+/* eTPU code image, run-length compressed at build time */
+extern const uint32_t *const my_etpu_code_rle;
+extern const uint32_t my_etpu_code_rle_size;
+#ifndef FS_ETPU_CODE_RLE_ONLY
+extern const uint32_t my_etpu_code_size;
+#endif
+
 #if 0
 /* Global <FUNC1> structures defined in etpu_gct.c */
 extern struct <func1>_instance_t <func1>_instance;
@@ -98,6 +107,8 @@ extern struct <func2>_states_t   <func2>_states;
 * Function Prototypes
 *******************************************************************************/
 int32_t my_system_etpu_init (void);
+int32_t my_system_etpu_init_rle(uint32_t *rle_code, uint32_t rle_code_size);
+int32_t my_system_etpu_warm_init(void);
 void    my_system_etpu_start(void);
 
 /*******************************************************************************
@@ -20,6 +20,80 @@
 
 uint32_t g_complete_flag = 0;
 
+/* code memory of eTPU A, from the chip-specific configuration */
+extern const uint32_t fs_etpu_code_start;
+
+/* startup benchmark - flash bytes read by each code loader and the
+   duration of each cold start in TCR1 counts */
+#define STARTUP_BENCH_WINDOW_US 2000
+struct
+{
+    uint32_t raw_flash_bytes;
+    uint32_t rle_flash_bytes;
+    uint32_t raw_init_time;
+    uint32_t rle_init_time;
+} g_startup_bench;
+
+/* idle load benchmark - engine A idle counts over 200 us of a quiet bus with
+   the slave instance selectable, without and with SS level polling, and the
+   engine counts the polling takes from it */
+struct
+{
+    uint32_t quiet_idle_cnt;
+    uint32_t poll_idle_cnt;
+    uint32_t poll_load_cnt;
+} g_idle_bench;
+
+/* angle schedule of the angle mode test, one entry per cylinder */
+struct spi_master_angle_entry_t spi_master_1_angle_table[2];
+
+
+/* output pin level of an eTPU A channel */
+uint32_t etpu_a_pin(uint8_t chan)
+{
+    return eTPU_AB->CHAN[chan].SCR.B.OPS;
+}
+
+/* poll an eTPU A output pin until it is at level - the TCR1 count it was
+   seen at goes to *p_tcr1, 1 is returned if it is not seen within poll_cnt
+   polls */
+uint32_t etpu_a_wait_pin(uint8_t chan, uint32_t level, uint32_t poll_cnt, uint32_t *p_tcr1)
+{
+    while (etpu_a_pin(chan) != level)
+    {
+        if (poll_cnt-- == 0) return 1;
+    }
+    *p_tcr1 = eTPU_AB->TB1R_A.B.TCR1;
+
+    return 0;
+}
+
+
+/* cold start at start_time from the code image (0 for the raw one) and
+   time it - the engines stop while the code loads, so the load takes the
+   part of the STARTUP_BENCH_WINDOW_US simulated time window which TCR1 did
+   not count after the restart; 1 is returned if the load fails or does not
+   fit the window */
+uint32_t startup_bench_load(uint32_t start_time, uint32_t *rle_code, uint32_t rle_code_size, uint32_t *p_tcr1_cnt)
+{
+    uint32_t window_cnt = STARTUP_BENCH_WINDOW_US * (etpu_a_tcr1_freq / 1000000);
+    uint32_t tcr1_start;
+
+    /* the cold starts re-allocate the frames */
+    if (fs_etpu_spi_slave_deinit(&spi_slave_1_instance)) return 1;
+    if (fs_etpu_spi_master_deinit(&spi_master_1_instance)) return 1;
+
+    at_time(start_time);
+    if (my_system_etpu_init_rle(rle_code, rle_code_size)) return 1;
+    my_system_etpu_start();
+    tcr1_start = eTPU_AB->TB1R_A.B.TCR1;
+    at_time(start_time + STARTUP_BENCH_WINDOW_US);
+    *p_tcr1_cnt = window_cnt - ((eTPU_AB->TB1R_A.B.TCR1 - tcr1_start) & 0xffffff);
+    if ((*p_tcr1_cnt == 0) || (*p_tcr1_cnt >= window_cnt)) return 1;
+
+    return 0;
+}
+
 
 uint32_t test_spi_word_transfer(uint32_t master_tx_word, uint32_t slave_tx_word, int8_t ss_index, uint32_t finish_time)
 {
@@ -64,6 +138,7 @@ int user_main()
     uint32_t slave_sclk_cisr_mask = 1 << (ETPU_SPI_SLAVE1_SCLK_CHAN & 0x1f);
     uint32_t slave_ss_cisr_mask = 1 << (ETPU_SPI_SLAVE1_SS_CHAN & 0x1f);
     uint32_t transfer_done_isr_cnt;
+    uint8_t crc_error;
 
 	/* initialize interrupt support */
 	isrLibInit();
@@ -108,6 +183,26 @@ int user_main()
     spi_slave_1_config.clock_polarity = 1;
     spi_slave_1_config.clock_phase = 1;
     if (test_spi_word_transfer(0x70, 0x67, -1, 1400)) return 1;
+
+    /* a rejected configuration (CRC needs MSB first) leaves the running
+       instances as they were - no re-init before the next word */
+    spi_master_1_config.crc_size = 8;
+    spi_slave_1_config.crc_size = 8;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_VALUE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_VALUE) return 1;
+    spi_master_1_config.crc_size = 0;
+    spi_slave_1_config.crc_size = 0;
+    fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0x96);
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x69, -1);
+    at_time(1500);
+    err_code = fs_etpu_spi_master_get_data(&spi_master_1_instance, &spi_master_1_config, &master_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (master_data != 0x96) return 1;
+    err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0x69) return 1;
     
     
     /******************************************/
@@ -258,9 +353,827 @@ int user_main()
     
 
 
+    /******************************************/
+    /* test CRC-8 SAE J1850, MSB first        */
+    /******************************************/
+
+    at_time(4000);
+    spi_master_1_config.shift_direction = FS_ETPU_SPI_MSB_FIRST;
+    spi_slave_1_config.shift_direction = FS_ETPU_SPI_MSB_FIRST;
+    spi_master_1_config.crc_size = 8;
+    spi_master_1_config.crc_polynomial = 0x1d;
+    spi_master_1_config.crc_init = 0xff;
+    spi_master_1_config.crc_xorout = 0xff;
+    spi_slave_1_config.crc_size = 8;
+    spi_slave_1_config.crc_polynomial = 0x1d;
+    spi_slave_1_config.crc_init = 0xff;
+    spi_slave_1_config.crc_xorout = 0xff;
+    if (test_spi_word_transfer(0xa3, 0x5a, 0, 4200)) return 1;
+    fs_etpu_spi_master_get_crc_error(&spi_master_1_instance, &crc_error);
+    if (crc_error != 0) return 1;
+    fs_etpu_spi_slave_get_crc_error(&spi_slave_1_instance, &crc_error);
+    if (crc_error != 0) return 1;
+    if (fs_etpu_get_global_exceptions_ext(EM_AB) & FS_ETPU_MICROCODE_GLOBAL_EX_A) return 1;
+
+    /* mismatched CRC init - both ends must flag the error with the channel
+       interrupt of the word, the engine is left without a global exception */
+    spi_slave_1_config.crc_init = 0x00;
+    fs_etpu_clear_chan_interrupt_flag_ext(spi_master_1_instance.em, spi_master_1_instance.clock_chan_num);
+    fs_etpu_clear_chan_interrupt_flag_ext(spi_slave_1_instance.em, spi_slave_1_instance.clock_chan_num);
+    if (test_spi_word_transfer(0xa3, 0x5a, 0, 4400)) return 1;
+    fs_etpu_spi_master_get_crc_error(&spi_master_1_instance, &crc_error);
+    if (crc_error != 1) return 1;
+    fs_etpu_spi_slave_get_crc_error(&spi_slave_1_instance, &crc_error);
+    if (crc_error != 1) return 1;
+    /* the error is sticky until read */
+    fs_etpu_spi_master_get_crc_error(&spi_master_1_instance, &crc_error);
+    if (crc_error != 0) return 1;
+    fs_etpu_spi_slave_get_crc_error(&spi_slave_1_instance, &crc_error);
+    if (crc_error != 0) return 1;
+    if (fs_etpu_get_chan_interrupt_flag_ext(spi_master_1_instance.em, spi_master_1_instance.clock_chan_num) == 0) return 1;
+    if (fs_etpu_get_chan_interrupt_flag_ext(spi_slave_1_instance.em, spi_slave_1_instance.clock_chan_num) == 0) return 1;
+    if (fs_etpu_get_global_exceptions_ext(EM_AB) & FS_ETPU_MICROCODE_GLOBAL_EX_A) return 1;
+
+    spi_master_1_config.crc_size = 0;
+    spi_slave_1_config.crc_size = 0;
+
+    /* burst read - 8-bit command followed by 3 response words under one ss */
+    at_time(5000);
+    spi_master_1_instance.burst_word_cnt_max = 4;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0x5a);
+    err_code = fs_etpu_spi_master_burst_read(&spi_master_1_instance, &spi_master_1_config, 0x9c, 8, 0x00, 3, 0);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    at_time(5500);
+    {
+        uint32_t burst_data[3];
+
+        err_code = fs_etpu_spi_master_get_burst_data(&spi_master_1_instance, &spi_master_1_config, burst_data, 3);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        /* slave reloads its data register at the start of every word */
+        if ((burst_data[0] != 0x5a) || (burst_data[1] != 0x5a) || (burst_data[2] != 0x5a)) return 1;
+    }
+    err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0x00) return 1;
+
+    /* daisy chain - 3 words under one ss followed by a latch pulse */
+    at_time(6000);
+    spi_master_1_instance.chain_word_cnt_max = 4;
+    spi_master_1_instance.latch_chan = ETPU_ENGINE_A_CHANNEL(10);
+    spi_master_1_config.latch_width_us = 5;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0xc3);
+    {
+        uint32_t chain_data[3] = { 0x11, 0x22, 0x33 };
+
+        err_code = fs_etpu_spi_master_chain_transmit(&spi_master_1_instance, &spi_master_1_config, chain_data, 3, 0, 0);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        at_time(6500);
+        err_code = fs_etpu_spi_master_get_chain_data(&spi_master_1_instance, &spi_master_1_config, chain_data, 3);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if ((chain_data[0] != 0xc3) || (chain_data[1] != 0xc3) || (chain_data[2] != 0xc3)) return 1;
+    }
+    /* the slave is last in the chain, it keeps the last word shifted */
+    err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0x33) return 1;
+    spi_master_1_config.latch_width_us = 0;
+
+    /* delayed MISO sample point, both clock phases */
+    spi_master_1_config.miso_sample_delay_ticks = 10;
+    spi_master_1_config.clock_phase = 0;
+    spi_slave_1_config.clock_phase = 0;
+    if (test_spi_word_transfer(0x96, 0x3c, 0, 7200)) return 1;
+    spi_master_1_config.clock_phase = 1;
+    spi_slave_1_config.clock_phase = 1;
+    if (test_spi_word_transfer(0x69, 0xc3, 0, 7400)) return 1;
+    spi_master_1_config.miso_sample_delay_ticks = 0;
+
+    /* DDR, a bit on each clock edge - the slave changes MISO a quarter bit after each edge */
+    spi_master_1_config.ddr = 1;
+    spi_slave_1_config.ddr = 1;
+    spi_slave_1_config.miso_hold_ticks = etpu_a_tcr1_freq / (spi_master_1_config.baud_rate_hz * 4);
+    if (test_spi_word_transfer(0xa5, 0x5a, 0, 7600)) return 1;
+    spi_master_1_config.shift_direction = FS_ETPU_SPI_LSB_FIRST;
+    spi_slave_1_config.shift_direction = FS_ETPU_SPI_LSB_FIRST;
+    if (test_spi_word_transfer(0x81, 0x7e, 0, 7800)) return 1;
+    spi_master_1_config.shift_direction = FS_ETPU_SPI_MSB_FIRST;
+    spi_slave_1_config.shift_direction = FS_ETPU_SPI_MSB_FIRST;
+    spi_master_1_config.ddr = 0;
+    spi_slave_1_config.ddr = 0;
+
+    /* streaming, I2S style frame of 2 words with the ss as word select */
+    at_time(8000);
+    spi_master_1_instance.stream_word_cnt = 4;
+    spi_master_1_config.stream_frame_word_cnt = 2;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    {
+        uint32_t stream_data[4] = { 0x11, 0x22, 0x11, 0x22 };
+
+        fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0x3c);
+        err_code = fs_etpu_spi_master_set_stream_data(&spi_master_1_instance, &spi_master_1_config, stream_data, 0, 4);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_master_stream_start(&spi_master_1_instance, &spi_master_1_config, 0);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        at_time(8250);
+        fs_etpu_spi_master_stream_stop(&spi_master_1_instance);
+        /* finishes at the end of a frame */
+        at_time(8500);
+        err_code = fs_etpu_spi_master_get_stream_data(&spi_master_1_instance, &spi_master_1_config, stream_data, 0, 4);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if ((stream_data[0] != 0x3c) || (stream_data[1] != 0x3c)) return 1;
+    }
+    err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0x22) return 1;
+
+    /* a stop inside a half ring - an 8 word ring stopped at once ends after
+       the first frame, at index 2, with the interrupt */
+    at_time(8600);
+    spi_master_1_instance.stream_word_cnt = 8;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    {
+        uint16_t stream_index;
+
+        eTPU_AB->CISR_A.R = master_sclk_cisr_mask;
+        err_code = fs_etpu_spi_master_stream_start(&spi_master_1_instance, &spi_master_1_config, 0);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_spi_master_stream_stop(&spi_master_1_instance);
+        at_time(8900);
+        if ((eTPU_AB->CISR_A.R & master_sclk_cisr_mask) == 0) return 1;
+        err_code = fs_etpu_spi_master_get_stream_index(&spi_master_1_instance, &stream_index);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (stream_index != 2) return 1;
+    }
+    spi_master_1_config.stream_frame_word_cnt = 0;
+    spi_master_1_instance.stream_word_cnt = 0;
+
+    /* single edge slave, one thread per bit - MISO changes a quarter bit after the sampling edge */
+    spi_slave_1_config.single_edge = 1;
+    spi_master_1_config.clock_phase = 0;
+    spi_slave_1_config.clock_phase = 0;
+    if (test_spi_word_transfer(0xb4, 0x4b, 0, 8600)) return 1;
+    spi_master_1_config.clock_phase = 1;
+    spi_slave_1_config.clock_phase = 1;
+    if (test_spi_word_transfer(0x2d, 0xd2, 0, 8800)) return 1;
+    spi_slave_1_config.single_edge = 0;
+
+    /* idle load of a selectable slave on a quiet bus - no threads unless SS level
+       polling is turned on */
+    at_time(9000);
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    at_time(9100);
+    fs_etpu_clear_idle_cnt_a_ext(spi_slave_1_instance.em);
+    at_time(9300);
+    g_idle_bench.quiet_idle_cnt = fs_etpu_get_idle_cnt_a_ext(spi_slave_1_instance.em);
+    spi_slave_1_config.ss_poll_period_us = 10;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    at_time(9400);
+    fs_etpu_clear_idle_cnt_a_ext(spi_slave_1_instance.em);
+    at_time(9600);
+    g_idle_bench.poll_idle_cnt = fs_etpu_get_idle_cnt_a_ext(spi_slave_1_instance.em);
+    if ((g_idle_bench.quiet_idle_cnt == 0) ||
+        (g_idle_bench.poll_idle_cnt >= g_idle_bench.quiet_idle_cnt)) return 1;
+    g_idle_bench.poll_load_cnt = g_idle_bench.quiet_idle_cnt - g_idle_bench.poll_idle_cnt;
+    spi_slave_1_config.ss_poll_period_us = 0;
+
+    /* register map - 16 bit words of a write flag, 3 address bits and 12 data bits,
+       the slave answers in the same word */
+    at_time(9700);
+    spi_master_1_config.transfer_size = 16;
+    spi_slave_1_config.transfer_size = 16;
+    spi_slave_1_instance.reg_addr_bit_cnt = 3;
+    spi_slave_1_config.reg_write_enable = 1;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_set_register(&spi_slave_1_instance, &spi_slave_1_config, 5, 0xabc);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    /* read register 5 */
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x5000, 0);
+    at_time(9900);
+    err_code = fs_etpu_spi_master_get_data(&spi_master_1_instance, &spi_master_1_config, &master_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if ((master_data & 0xfff) != 0xabc) return 1;
+    /* write register 2 */
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0xa123, 0);
+    at_time(10100);
+    err_code = fs_etpu_spi_slave_get_register(&spi_slave_1_instance, &spi_slave_1_config, 2, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0x123) return 1;
+    spi_slave_1_config.reg_write_enable = 0;
+    spi_slave_1_instance.reg_addr_bit_cnt = 0;
+    spi_master_1_config.transfer_size = 8;
+    spi_slave_1_config.transfer_size = 8;
+
+    /* SS delimited frame - a 4 bit command and 3 words make a 28 bit frame, the
+       slave interrupts once, from the SS channel, at its end */
+    at_time(10200);
+    spi_slave_1_instance.frame_word_cnt_max = 4;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    eTPU_AB->CISR_A.R = slave_sclk_cisr_mask | slave_ss_cisr_mask;
+    err_code = fs_etpu_spi_master_burst_read(&spi_master_1_instance, &spi_master_1_config, 0x9, 4, 0x00, 3, 0);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    at_time(10700);
+    cisr = eTPU_AB->CISR_A.R;
+    if ((cisr & slave_sclk_cisr_mask) || !(cisr & slave_ss_cisr_mask)) return 1;
+    eTPU_AB->CISR_A.R = slave_ss_cisr_mask;
+    {
+        uint32_t frame_data[4];
+        uint32_t frame_bit_cnt;
+
+        err_code = fs_etpu_spi_slave_get_frame(&spi_slave_1_instance, &spi_slave_1_config, frame_data, &frame_bit_cnt);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (frame_bit_cnt != 28) return 1;
+        if ((frame_data[0] != 0x90) || (frame_data[1] != 0x00) || (frame_data[2] != 0x00) || (frame_data[3] != 0x0)) return 1;
+    }
+    spi_slave_1_instance.frame_word_cnt_max = 0;
+
+    /* two virtual devices on one slave, each with its own data registers */
+    at_time(10800);
+    /* without virtual devices there are no device data registers */
+    err_code = fs_etpu_spi_slave_get_device_data(&spi_slave_1_instance, &spi_slave_1_config, 0, &slave_data);
+    if (err_code != FS_ETPU_ERROR_VALUE) return 1;
+    err_code = fs_etpu_spi_slave_set_device_data(&spi_slave_1_instance, &spi_slave_1_config, 0, 0x11);
+    if (err_code != FS_ETPU_ERROR_VALUE) return 1;
+    spi_master_1_instance.slave_select_chan_list[1] = ETPU_SPI_MASTER1_SS2_CHAN;
+    spi_slave_1_instance.ss_device_cnt = 2;
+    spi_slave_1_instance.ss_device_chan_list[0] = ETPU_SPI_SLAVE1_SS2_CHAN;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    fs_etpu_spi_slave_set_device_data(&spi_slave_1_instance, &spi_slave_1_config, 0, 0x11);
+    fs_etpu_spi_slave_set_device_data(&spi_slave_1_instance, &spi_slave_1_config, 1, 0x22);
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x5a, 1);
+    at_time(11000);
+    {
+        uint8_t device_index;
+
+        err_code = fs_etpu_spi_master_get_data(&spi_master_1_instance, &spi_master_1_config, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0x22) return 1;
+        err_code = fs_etpu_spi_slave_get_device_data(&spi_slave_1_instance, &spi_slave_1_config, 1, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x5a) return 1;
+        fs_etpu_spi_slave_get_data_index(&spi_slave_1_instance, &device_index);
+        if (device_index != 1) return 1;
+        fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0xa5, 0);
+        at_time(11200);
+        err_code = fs_etpu_spi_master_get_data(&spi_master_1_instance, &spi_master_1_config, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0x11) return 1;
+        err_code = fs_etpu_spi_slave_get_device_data(&spi_slave_1_instance, &spi_slave_1_config, 0, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0xa5) return 1;
+        fs_etpu_spi_slave_get_data_index(&spi_slave_1_instance, &device_index);
+        if (device_index != 0) return 1;
+    }
+    spi_slave_1_instance.ss_device_cnt = 0;
+    spi_master_1_instance.slave_select_chan_list[1] = 0xff;
+
+    /* counters - two words in without a read overrun on both sides, the
+       snapshot resets them */
+    at_time(11300);
+    spi_master_1_instance.counter_enable = 1;
+    spi_slave_1_instance.counter_enable = 1;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x31, 0);
+    at_time(11500);
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x32, 0);
+    at_time(11700);
+    {
+        struct spi_counters_t counters;
+
+        err_code = fs_etpu_spi_slave_get_counters(&spi_slave_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (counters.rx_overrun_cnt != 1) return 1;
+        if ((counters.timeout_cnt != 0) || (counters.abort_cnt != 0) || (counters.error_cnt != 0)) return 1;
+        err_code = fs_etpu_spi_master_get_counters(&spi_master_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (counters.rx_overrun_cnt != 1) return 1;
+        if (counters.error_cnt != 0) return 1;
+        err_code = fs_etpu_spi_slave_get_counters(&spi_slave_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (counters.rx_overrun_cnt != 0) return 1;
+    }
+
+    /* a 32 bit slave word - the master sends it as a 16 bit command and one
+       16 bit word under one select */
+    at_time(11800);
+    spi_master_1_config.transfer_size = 16;
+    spi_slave_1_config.transfer_size = 32;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0xcafe0123);
+    err_code = fs_etpu_spi_master_burst_read(&spi_master_1_instance, &spi_master_1_config, 0x1234, 16, 0x5678, 1, 0);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    at_time(12300);
+    err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0x12345678) return 1;
+    err_code = fs_etpu_spi_master_get_burst_data(&spi_master_1_instance, &spi_master_1_config, &master_data, 1);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (master_data != 0x0123) return 1;
+    spi_master_1_config.transfer_size = 8;
+    spi_slave_1_config.transfer_size = 8;
+
+    /* glitch check - a minimum edge spacing over the real half bit time drops the
+       word as a glitch, and the rest of the select is ignored; an in spec spacing
+       passes the next word */
+    at_time(12600);
+    spi_slave_1_config.min_edge_ticks = (etpu_a_tcr1_freq / spi_master_1_config.baud_rate_hz) * 2;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    eTPU_AB->CISR_A.R = slave_sclk_cisr_mask;
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0xc3, 0);
+    at_time(12800);
+    {
+        struct spi_counters_t counters;
+
+        if (eTPU_AB->CISR_A.R & slave_sclk_cisr_mask) return 1;
+        err_code = fs_etpu_spi_slave_get_counters(&spi_slave_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (counters.glitch_cnt != 1) return 1;
+        spi_slave_1_config.min_edge_ticks = etpu_a_tcr1_freq / (spi_master_1_config.baud_rate_hz * 4);
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x3c, 0);
+        at_time(13000);
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x3c) return 1;
+        err_code = fs_etpu_spi_slave_get_counters(&spi_slave_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (counters.glitch_cnt != 0) return 1;
+    }
+    spi_slave_1_config.min_edge_ticks = 0;
+
+    /* SCLK period - measured by the slave, within 10% of the master's, only
+       when enabled */
+    at_time(13100);
+    {
+        struct spi_sclk_period_t period;
+        uint32_t period_ticks = etpu_a_tcr1_freq / spi_master_1_config.baud_rate_hz;
+
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_slave_get_sclk_period(&spi_slave_1_instance, &spi_slave_1_config, &period, 1);
+        if (err_code != FS_ETPU_ERROR_VALUE) return 1;
+        spi_slave_1_config.sclk_period_enable = 1;
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_slave_get_sclk_period(&spi_slave_1_instance, &spi_slave_1_config, &period, 1);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x96, 0);
+        at_time(13300);
+        err_code = fs_etpu_spi_slave_get_sclk_period(&spi_slave_1_instance, &spi_slave_1_config, &period, 0);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if ((period.period_avg < period_ticks - period_ticks / 10) ||
+            (period.period_avg > period_ticks + period_ticks / 10)) return 1;
+        if ((period.period_min > period.period_avg) || (period.period_max < period.period_avg)) return 1;
+        spi_slave_1_config.sclk_period_enable = 0;
+    }
+
+    /* deinit returns the DATA RAM - a new init reuses it rather than taking
+       more from the top; a re-init resizes a grown buffer and frees a dropped
+       one */
+    at_time(13400);
+    {
+        struct etpu_sdm_stats_t stats_before;
+        struct etpu_sdm_stats_t stats_free;
+        struct etpu_sdm_stats_t stats_stream;
+        struct etpu_sdm_stats_t stats;
+        uint32_t stream_bytes;
+
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats_before);
+        err_code = fs_etpu_spi_slave_deinit(&spi_slave_1_instance);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_master_deinit(&spi_master_1_instance);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats_free);
+        if (stats_free.used_bytes >= stats_before.used_bytes) return 1;
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats);
+        if ((stats.used_bytes != stats_before.used_bytes) ||
+            (stats.top_bytes < stats_before.top_bytes) ||
+            (stats.fail_cnt != 0)) return 1;
+
+        /* a stream ring grown from 4 to 8 words and dropped, counters dropped
+           and back */
+        spi_master_1_instance.stream_word_cnt = 4;
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        stream_bytes = spi_master_1_instance.stream_buffer_bytes;
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats_stream);
+        spi_master_1_instance.stream_word_cnt = 8;
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (spi_master_1_instance.stream_buffer_bytes != stream_bytes + 4 * sizeof(uint32_t)) return 1;
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats);
+        if (stats.used_bytes != stats_stream.used_bytes + 4 * sizeof(uint32_t)) return 1;
+        spi_master_1_instance.stream_word_cnt = 0;
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if ((spi_master_1_instance.stream_buffer_pse != 0) || (spi_master_1_instance.stream_buffer_bytes != 0)) return 1;
+        spi_slave_1_instance.counter_enable = 0;
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (spi_slave_1_instance.counters_pse != 0) return 1;
+        spi_slave_1_instance.counter_enable = 1;
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats);
+        if ((stats.used_bytes != stats_before.used_bytes) || (stats.fail_cnt != 0)) return 1;
+
+        /* the pair gives back all it holds */
+        err_code = fs_etpu_spi_slave_deinit(&spi_slave_1_instance);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_master_deinit(&spi_master_1_instance);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats);
+        if (stats.used_bytes != stats_free.used_bytes) return 1;
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0xa5, 0);
+        at_time(13600);
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0xa5) return 1;
+    }
+
+    /* cold start from the compressed code image - expanded into code memory
+       and checked there, the link works as after the raw load; each load is
+       timed */
+    at_time(13800);
+    {
+        g_startup_bench.raw_flash_bytes = my_etpu_code_size;
+        g_startup_bench.rle_flash_bytes = my_etpu_code_rle_size;
+        if (g_startup_bench.rle_flash_bytes >= g_startup_bench.raw_flash_bytes) return 1;
+
+        if (startup_bench_load(13900, 0, 0, &g_startup_bench.raw_init_time)) return 1;
+
+        /* a cut short image is refused */
+        if (fs_etpu_spi_slave_deinit(&spi_slave_1_instance)) return 1;
+        if (fs_etpu_spi_master_deinit(&spi_master_1_instance)) return 1;
+        if (my_system_etpu_init_rle((uint32_t *)my_etpu_code_rle, my_etpu_code_rle_size - 4) != FS_ETPU_ERROR_CHECKSUM) return 1;
+
+        if (startup_bench_load(16000, (uint32_t *)my_etpu_code_rle, my_etpu_code_rle_size, &g_startup_bench.rle_init_time)) return 1;
+
+        fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x5c, 0);
+        at_time(18200);
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x5c) return 1;
+    }
+
+    /* warm restart - a host reset with the eTPU running on, re-attach
+       while a transfer is on the bus */
+    at_time(18300);
+    {
+        struct etpu_sdm_stats_t stats_before;
+        struct etpu_sdm_stats_t stats;
+        volatile uint32_t *p_code_word;
+
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats_before);
+
+        /* code memory which does not read back as built is refused, MISC
+           being off */
+        p_code_word = (volatile uint32_t *)(fs_etpu_code_start + FS_ETPU_CODE_RLE_SIZE(my_etpu_code_rle) - 4);
+        eTPU_AB->MCR.B.VIS = 1;
+        *p_code_word ^= 1;
+        eTPU_AB->MCR.B.VIS = 0;
+        err_code = my_system_etpu_warm_init();
+        eTPU_AB->MCR.B.VIS = 1;
+        *p_code_word ^= 1;
+        eTPU_AB->MCR.B.VIS = 0;
+        if (err_code != FS_ETPU_ERROR_CHECKSUM) return 1;
+
+        fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0xa3, 0);
+
+        /* the host forgets all it had */
+        spi_master_1_instance.cpba = 0;
+        spi_master_1_instance.cpba_pse = 0;
+        spi_master_1_instance.angle_table_pse = 0;
+        spi_master_1_instance.angle_table_bytes = 0;
+        spi_master_1_instance.burst_buffer_pse = 0;
+        spi_master_1_instance.burst_buffer_bytes = 0;
+        spi_master_1_instance.chain_buffer_pse = 0;
+        spi_master_1_instance.chain_buffer_bytes = 0;
+        spi_master_1_instance.stream_buffer_pse = 0;
+        spi_master_1_instance.stream_buffer_bytes = 0;
+        spi_master_1_instance.crc_pse = 0;
+        spi_master_1_instance.crc_bytes = 0;
+        spi_master_1_instance.counters_pse = 0;
+        spi_master_1_instance.counters_bytes = 0;
+        spi_slave_1_instance.cpba = 0;
+        spi_slave_1_instance.cpba_pse = 0;
+        spi_slave_1_instance.reg_table_pse = 0;
+        spi_slave_1_instance.reg_table_bytes = 0;
+        spi_slave_1_instance.frame_buffer_pse = 0;
+        spi_slave_1_instance.frame_buffer_bytes = 0;
+        spi_slave_1_instance.dev_buffer_pse = 0;
+        spi_slave_1_instance.dev_buffer_bytes = 0;
+        spi_slave_1_instance.crc_pse = 0;
+        spi_slave_1_instance.crc_bytes = 0;
+        spi_slave_1_instance.long_pse = 0;
+        spi_slave_1_instance.long_bytes = 0;
+        spi_slave_1_instance.edge_pse = 0;
+        spi_slave_1_instance.edge_bytes = 0;
+        spi_slave_1_instance.counters_pse = 0;
+        spi_slave_1_instance.counters_bytes = 0;
+
+        /* an instance which does not match its frame is refused */
+        spi_master_1_instance.stream_word_cnt ^= 1;
+        if ((my_system_etpu_warm_init() & 0xffff) != FS_ETPU_ERROR_CHECKSUM) return 1;
+        spi_master_1_instance.stream_word_cnt ^= 1;
+
+        if (my_system_etpu_warm_init()) return 1;
+        fs_etpu_get_sdm_stats_ext(EM_AB, &stats);
+        if (stats.used_bytes != stats_before.used_bytes) return 1;
+        if (stats.top_bytes != stats_before.top_bytes) return 1;
+
+        at_time(18500);
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0xa3) return 1;
+    }
+
+    /* angle schedule - two entries on TCR2 (angle mode is off in this setup, so
+       it counts time), each starts a word at its target and gets its own data
+       in; the host moves an entry once it has been served */
+    at_time(18600);
+    {
+        uint32_t tcr2;
+        uint32_t tcr2_per_ms = etpu_a_tcr2_freq / 1000;
+
+        if (fs_etpu_spi_master_deinit(&spi_master_1_instance)) return 1;
+        tcr2 = eTPU_AB->TB2R_A.B.TCR2;
+        spi_master_1_angle_table[0].angle = (tcr2 + tcr2_per_ms * 200 / 1000) & 0xffffff;
+        spi_master_1_angle_table[0].data = 0x11;
+        spi_master_1_angle_table[0].slave_select_index = 0;
+        spi_master_1_angle_table[1].angle = (tcr2 + tcr2_per_ms * 500 / 1000) & 0xffffff;
+        spi_master_1_angle_table[1].data = 0x22;
+        spi_master_1_angle_table[1].slave_select_index = 0;
+        spi_master_1_instance.angle_table = spi_master_1_angle_table;
+        spi_master_1_instance.angle_entry_cnt = 2;
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0x5a);
+
+        /* nothing before the first target, the word is under way after it */
+        at_time(18750);
+        if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+        err_code = fs_etpu_spi_master_get_angle_data(&spi_master_1_instance, &spi_master_1_config, 0, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0) return 1;
+        at_time(18850);
+        if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 0) return 1;
+        at_time(18950);
+        if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+        err_code = fs_etpu_spi_master_get_angle_data(&spi_master_1_instance, &spi_master_1_config, 0, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0x5a) return 1;
+        err_code = fs_etpu_spi_master_get_angle_data(&spi_master_1_instance, &spi_master_1_config, 1, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0) return 1;
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x11) return 1;
+
+        /* entry 0 is next after entry 1 - move it a quarter of the TCR2 range on */
+        fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0xa5);
+        spi_master_1_angle_table[0].angle = (tcr2 + 0x400000) & 0xffffff;
+        err_code = fs_etpu_spi_master_set_angle_entry(&spi_master_1_instance, &spi_master_1_config, 0);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+
+        at_time(19050);
+        if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+        at_time(19150);
+        if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 0) return 1;
+        at_time(19250);
+        if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+        err_code = fs_etpu_spi_master_get_angle_data(&spi_master_1_instance, &spi_master_1_config, 1, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0xa5) return 1;
+        err_code = fs_etpu_spi_master_get_angle_data(&spi_master_1_instance, &spi_master_1_config, 0, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0x5a) return 1;
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x22) return 1;
+
+        /* back to host started transfers */
+        if (fs_etpu_spi_master_deinit(&spi_master_1_instance)) return 1;
+        spi_master_1_instance.angle_table = 0;
+        spi_master_1_instance.angle_entry_cnt = 0;
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    }
+
+    /* decoder addressed selects - a 3 bit address on channels 12 to 14, the
+       first slave select is the decoder enable; the address leads the enable
+       by half a bit, the enable leads the first clock edge by the slave
+       select delay */
+    at_time(19300);
+    spi_master_1_instance.ss_decoder_addr_bit_cnt = 3;
+    spi_master_1_instance.ss_decoder_addr_chan = ETPU_ENGINE_A_CHANNEL(12);
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    /* only 8 devices on 3 address bits */
+    err_code = fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x6b, 8);
+    if (err_code != FS_ETPU_ERROR_VALUE) return 1;
+    at_time(19350);
+    if ((etpu_a_pin(ETPU_ENGINE_A_CHANNEL(12)) != 0) ||
+        (etpu_a_pin(ETPU_ENGINE_A_CHANNEL(13)) != 0) ||
+        (etpu_a_pin(ETPU_ENGINE_A_CHANNEL(14)) != 0)) return 1;
+    fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0x3c);
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x6b, 5);
+    at_time(19352);
+    if ((etpu_a_pin(ETPU_ENGINE_A_CHANNEL(12)) != 1) ||
+        (etpu_a_pin(ETPU_ENGINE_A_CHANNEL(13)) != 0) ||
+        (etpu_a_pin(ETPU_ENGINE_A_CHANNEL(14)) != 1)) return 1;
+    if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+    at_time(19360);
+    if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 0) return 1;
+    if (etpu_a_pin(ETPU_SPI_MASTER1_SCLK_CHAN) != spi_master_1_config.clock_polarity) return 1;
+    at_time(19372);
+    if (etpu_a_pin(ETPU_SPI_MASTER1_SCLK_CHAN) != spi_master_1_config.clock_polarity) return 1;
+    at_time(19500);
+    if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+    err_code = fs_etpu_spi_master_get_data(&spi_master_1_instance, &spi_master_1_config, &master_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (master_data != 0x3c) return 1;
+    err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0x6b) return 1;
+    /* the next device - the address changes before the enable */
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0xb6, 2);
+    at_time(19502);
+    if ((etpu_a_pin(ETPU_ENGINE_A_CHANNEL(12)) != 0) ||
+        (etpu_a_pin(ETPU_ENGINE_A_CHANNEL(13)) != 1) ||
+        (etpu_a_pin(ETPU_ENGINE_A_CHANNEL(14)) != 0)) return 1;
+    if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+    at_time(19650);
+    err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    if (slave_data != 0xb6) return 1;
+    spi_master_1_instance.ss_decoder_addr_bit_cnt = 0;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+
+    /* daisy chain refresh - repeated every 500 us from one host start, each
+       time followed by a 20 us low going latch pulse; data changed between
+       refreshes goes out on the next one, and a stop ends the repeats; the
+       chain data is not read, so the second chain counts a read overrun */
+    at_time(19700);
+    spi_master_1_config.latch_width_us = 20;
+    spi_master_1_config.latch_polarity = 1;
+    spi_master_1_config.chain_refresh_period_us = 500;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    at_time(19750);
+    {
+        uint32_t chain_data[3] = { 0x11, 0x22, 0x33 };
+        uint32_t latch_start[2], latch_end;
+        uint32_t ticks, ticks_expected;
+        uint32_t tcr1_per_ms = etpu_a_tcr1_freq / 1000;
+        struct spi_counters_t counters;
+
+        /* the snapshot resets the counters */
+        err_code = fs_etpu_spi_master_get_counters(&spi_master_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        /* latch idles at its polarity level */
+        if (etpu_a_pin(spi_master_1_instance.latch_chan) != 1) return 1;
+        err_code = fs_etpu_spi_master_chain_transmit(&spi_master_1_instance, &spi_master_1_config, chain_data, 3, 0, 1);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (etpu_a_wait_pin(spi_master_1_instance.latch_chan, 0, 10000000, &latch_start[0])) return 1;
+        if (etpu_a_wait_pin(spi_master_1_instance.latch_chan, 1, 10000000, &latch_end)) return 1;
+        ticks = (latch_end - latch_start[0]) & 0xffffff;
+        ticks_expected = tcr1_per_ms * 20 / 1000;
+        if ((ticks < ticks_expected - ticks_expected / 20) ||
+            (ticks > ticks_expected + ticks_expected / 20)) return 1;
+        /* the latch follows the slave select release */
+        if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 1) return 1;
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x33) return 1;
+
+        chain_data[2] = 0x44;
+        err_code = fs_etpu_spi_master_set_chain_data(&spi_master_1_instance, &spi_master_1_config, chain_data, 3);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (etpu_a_wait_pin(spi_master_1_instance.latch_chan, 0, 10000000, &latch_start[1])) return 1;
+        if (etpu_a_wait_pin(spi_master_1_instance.latch_chan, 1, 10000000, &latch_end)) return 1;
+        ticks = (latch_start[1] - latch_start[0]) & 0xffffff;
+        ticks_expected = tcr1_per_ms * 500 / 1000;
+        if ((ticks < ticks_expected - ticks_expected / 100) ||
+            (ticks > ticks_expected + ticks_expected / 100)) return 1;
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x44) return 1;
+
+        /* stopped before the next refresh is due - no more chains */
+        at_time(20600);
+        err_code = fs_etpu_spi_master_chain_stop(&spi_master_1_instance);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        eTPU_AB->CISR_A.R = master_sclk_cisr_mask;
+        at_time(21600);
+        if (eTPU_AB->CISR_A.R & master_sclk_cisr_mask) return 1;
+        if (etpu_a_pin(spi_master_1_instance.latch_chan) != 1) return 1;
+        err_code = fs_etpu_spi_master_get_counters(&spi_master_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (counters.rx_overrun_cnt != 1) return 1;
+        if (counters.error_cnt != 0) return 1;
+    }
+    spi_master_1_config.latch_width_us = 0;
+    spi_master_1_config.latch_polarity = 0;
+    spi_master_1_config.chain_refresh_period_us = 0;
+    err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+
+    /* SCLK timeout - the master stops mid-word (SCLK at its idle level, SS
+       held), the slave drops the word once timeout_us has passed from its
+       first edge and takes the next word normally */
+    at_time(21700);
+    err_code = fs_etpu_spi_slave_init(&spi_slave_1_instance, &spi_slave_1_config);
+    if (err_code != FS_ETPU_ERROR_NONE) return 1;
+    fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0x5a, 0);
+    at_time(21757);
+    if (fs_etpu_spi_master_deinit(&spi_master_1_instance)) return 1;
+    if (etpu_a_pin(ETPU_SPI_MASTER1_SS_CHAN) != 0) return 1;
+    {
+        struct spi_counters_t counters;
+
+        /* first edge at 21720, not timed out yet */
+        at_time(22600);
+        err_code = fs_etpu_spi_slave_get_counters(&spi_slave_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (counters.timeout_cnt != 0) return 1;
+        at_time(22800);
+        err_code = fs_etpu_spi_slave_get_counters(&spi_slave_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if ((counters.timeout_cnt != 1) || (counters.abort_cnt != 0)) return 1;
+        /* the partial word is not stored */
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0x44) return 1;
+
+        /* the master init releases SS, the next word gets through */
+        err_code = fs_etpu_spi_master_init(&spi_master_1_instance, &spi_master_1_config);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        fs_etpu_spi_slave_set_data(&spi_slave_1_instance, &spi_slave_1_config, 0x99);
+        fs_etpu_spi_master_transmit_data(&spi_master_1_instance, &spi_master_1_config, 0xc3, 0);
+        at_time(23000);
+        err_code = fs_etpu_spi_master_get_data(&spi_master_1_instance, &spi_master_1_config, &master_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (master_data != 0x99) return 1;
+        err_code = fs_etpu_spi_slave_get_data(&spi_slave_1_instance, &spi_slave_1_config, &slave_data);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if (slave_data != 0xc3) return 1;
+        err_code = fs_etpu_spi_slave_get_counters(&spi_slave_1_instance, &counters);
+        if (err_code != FS_ETPU_ERROR_NONE) return 1;
+        if ((counters.timeout_cnt != 0) || (counters.abort_cnt != 0)) return 1;
+    }
+
+
 	/* TESTING DONE */
-	
-	at_time(4000);
+
+	at_time(23100);
 
 	g_complete_flag = 1;
 